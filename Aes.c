@@ -67,6 +67,22 @@ If not, pad the end of the data with zeros to reach the 16 byte boundary.
   #define MULTIPLY_AS_A_FUNCTION 1
 #endif
 
+#if defined(AES_TTABLE) && (AES_TTABLE == 1)
+// The state is held as 4 little endian column words: byte r of column c is row r.
+#define GET_WORD(pBuf)      ((uint32_t)(pBuf)[0] | ((uint32_t)(pBuf)[1] << 8) | ((uint32_t)(pBuf)[2] << 16) | ((uint32_t)(pBuf)[3] << 24))
+#define PUT_WORD(pBuf, W)   { (pBuf)[0] = (uint8_t)(W); (pBuf)[1] = (uint8_t)((W) >> 8); (pBuf)[2] = (uint8_t)((W) >> 16); (pBuf)[3] = (uint8_t)((W) >> 24); }
+#define BYTE0(W)            ((W) & 0xFFu)
+#define BYTE1(W)            (((W) >> 8) & 0xFFu)
+#define BYTE2(W)            (((W) >> 16) & 0xFFu)
+#define BYTE3(W)            ((W) >> 24)
+#define ROTL8(W)            (((W) << 8) | ((W) >> 24))
+#define ROTL16(W)           (((W) << 16) | ((W) >> 16))
+#define ROTL24(W)           (((W) << 24) | ((W) >> 8))
+#define DECRYPT_ROUND_KEY(Ctx)  ((Ctx)->InvRoundKey)
+#else
+#define DECRYPT_ROUND_KEY(Ctx)  ((Ctx)->RoundKey)
+#endif
+
 const uint8_t Iv[16]  =
 {
     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
@@ -141,6 +157,86 @@ static const uint8_t RSBox[256] =
 };
 #endif
 
+#if defined(AES_TTABLE) && (AES_TTABLE == 1)
+// Encryption T-table: MixColumns of (SBox[x], 0, 0, 0) as a little endian column.
+// Row r of a column uses the entry rotated left by 8*r bits.
+static const uint32_t TeTable[256] =
+{
+    0xa56363c6u, 0x847c7cf8u, 0x997777eeu, 0x8d7b7bf6u, 0x0df2f2ffu, 0xbd6b6bd6u, 0xb16f6fdeu, 0x54c5c591u,
+    0x50303060u, 0x03010102u, 0xa96767ceu, 0x7d2b2b56u, 0x19fefee7u, 0x62d7d7b5u, 0xe6abab4du, 0x9a7676ecu,
+    0x45caca8fu, 0x9d82821fu, 0x40c9c989u, 0x877d7dfau, 0x15fafaefu, 0xeb5959b2u, 0xc947478eu, 0x0bf0f0fbu,
+    0xecadad41u, 0x67d4d4b3u, 0xfda2a25fu, 0xeaafaf45u, 0xbf9c9c23u, 0xf7a4a453u, 0x967272e4u, 0x5bc0c09bu,
+    0xc2b7b775u, 0x1cfdfde1u, 0xae93933du, 0x6a26264cu, 0x5a36366cu, 0x413f3f7eu, 0x02f7f7f5u, 0x4fcccc83u,
+    0x5c343468u, 0xf4a5a551u, 0x34e5e5d1u, 0x08f1f1f9u, 0x937171e2u, 0x73d8d8abu, 0x53313162u, 0x3f15152au,
+    0x0c040408u, 0x52c7c795u, 0x65232346u, 0x5ec3c39du, 0x28181830u, 0xa1969637u, 0x0f05050au, 0xb59a9a2fu,
+    0x0907070eu, 0x36121224u, 0x9b80801bu, 0x3de2e2dfu, 0x26ebebcdu, 0x6927274eu, 0xcdb2b27fu, 0x9f7575eau,
+    0x1b090912u, 0x9e83831du, 0x742c2c58u, 0x2e1a1a34u, 0x2d1b1b36u, 0xb26e6edcu, 0xee5a5ab4u, 0xfba0a05bu,
+    0xf65252a4u, 0x4d3b3b76u, 0x61d6d6b7u, 0xceb3b37du, 0x7b292952u, 0x3ee3e3ddu, 0x712f2f5eu, 0x97848413u,
+    0xf55353a6u, 0x68d1d1b9u, 0x00000000u, 0x2cededc1u, 0x60202040u, 0x1ffcfce3u, 0xc8b1b179u, 0xed5b5bb6u,
+    0xbe6a6ad4u, 0x46cbcb8du, 0xd9bebe67u, 0x4b393972u, 0xde4a4a94u, 0xd44c4c98u, 0xe85858b0u, 0x4acfcf85u,
+    0x6bd0d0bbu, 0x2aefefc5u, 0xe5aaaa4fu, 0x16fbfbedu, 0xc5434386u, 0xd74d4d9au, 0x55333366u, 0x94858511u,
+    0xcf45458au, 0x10f9f9e9u, 0x06020204u, 0x817f7ffeu, 0xf05050a0u, 0x443c3c78u, 0xba9f9f25u, 0xe3a8a84bu,
+    0xf35151a2u, 0xfea3a35du, 0xc0404080u, 0x8a8f8f05u, 0xad92923fu, 0xbc9d9d21u, 0x48383870u, 0x04f5f5f1u,
+    0xdfbcbc63u, 0xc1b6b677u, 0x75dadaafu, 0x63212142u, 0x30101020u, 0x1affffe5u, 0x0ef3f3fdu, 0x6dd2d2bfu,
+    0x4ccdcd81u, 0x140c0c18u, 0x35131326u, 0x2fececc3u, 0xe15f5fbeu, 0xa2979735u, 0xcc444488u, 0x3917172eu,
+    0x57c4c493u, 0xf2a7a755u, 0x827e7efcu, 0x473d3d7au, 0xac6464c8u, 0xe75d5dbau, 0x2b191932u, 0x957373e6u,
+    0xa06060c0u, 0x98818119u, 0xd14f4f9eu, 0x7fdcdca3u, 0x66222244u, 0x7e2a2a54u, 0xab90903bu, 0x8388880bu,
+    0xca46468cu, 0x29eeeec7u, 0xd3b8b86bu, 0x3c141428u, 0x79dedea7u, 0xe25e5ebcu, 0x1d0b0b16u, 0x76dbdbadu,
+    0x3be0e0dbu, 0x56323264u, 0x4e3a3a74u, 0x1e0a0a14u, 0xdb494992u, 0x0a06060cu, 0x6c242448u, 0xe45c5cb8u,
+    0x5dc2c29fu, 0x6ed3d3bdu, 0xefacac43u, 0xa66262c4u, 0xa8919139u, 0xa4959531u, 0x37e4e4d3u, 0x8b7979f2u,
+    0x32e7e7d5u, 0x43c8c88bu, 0x5937376eu, 0xb76d6ddau, 0x8c8d8d01u, 0x64d5d5b1u, 0xd24e4e9cu, 0xe0a9a949u,
+    0xb46c6cd8u, 0xfa5656acu, 0x07f4f4f3u, 0x25eaeacfu, 0xaf6565cau, 0x8e7a7af4u, 0xe9aeae47u, 0x18080810u,
+    0xd5baba6fu, 0x887878f0u, 0x6f25254au, 0x722e2e5cu, 0x241c1c38u, 0xf1a6a657u, 0xc7b4b473u, 0x51c6c697u,
+    0x23e8e8cbu, 0x7cdddda1u, 0x9c7474e8u, 0x211f1f3eu, 0xdd4b4b96u, 0xdcbdbd61u, 0x868b8b0du, 0x858a8a0fu,
+    0x907070e0u, 0x423e3e7cu, 0xc4b5b571u, 0xaa6666ccu, 0xd8484890u, 0x05030306u, 0x01f6f6f7u, 0x120e0e1cu,
+    0xa36161c2u, 0x5f35356au, 0xf95757aeu, 0xd0b9b969u, 0x91868617u, 0x58c1c199u, 0x271d1d3au, 0xb99e9e27u,
+    0x38e1e1d9u, 0x13f8f8ebu, 0xb398982bu, 0x33111122u, 0xbb6969d2u, 0x70d9d9a9u, 0x898e8e07u, 0xa7949433u,
+    0xb69b9b2du, 0x221e1e3cu, 0x92878715u, 0x20e9e9c9u, 0x49cece87u, 0xff5555aau, 0x78282850u, 0x7adfdfa5u,
+    0x8f8c8c03u, 0xf8a1a159u, 0x80898909u, 0x170d0d1au, 0xdabfbf65u, 0x31e6e6d7u, 0xc6424284u, 0xb86868d0u,
+    0xc3414182u, 0xb0999929u, 0x772d2d5au, 0x110f0f1eu, 0xcbb0b07bu, 0xfc5454a8u, 0xd6bbbb6du, 0x3a16162cu
+};
+
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+// Decryption T-table: InvMixColumns of (RSBox[x], 0, 0, 0) as a little endian column.
+// Row r of a column uses the entry rotated left by 8*r bits.
+static const uint32_t TdTable[256] =
+{
+    0x50a7f451u, 0x5365417eu, 0xc3a4171au, 0x965e273au, 0xcb6bab3bu, 0xf1459d1fu, 0xab58faacu, 0x9303e34bu,
+    0x55fa3020u, 0xf66d76adu, 0x9176cc88u, 0x254c02f5u, 0xfcd7e54fu, 0xd7cb2ac5u, 0x80443526u, 0x8fa362b5u,
+    0x495ab1deu, 0x671bba25u, 0x980eea45u, 0xe1c0fe5du, 0x02752fc3u, 0x12f04c81u, 0xa397468du, 0xc6f9d36bu,
+    0xe75f8f03u, 0x959c9215u, 0xeb7a6dbfu, 0xda595295u, 0x2d83bed4u, 0xd3217458u, 0x2969e049u, 0x44c8c98eu,
+    0x6a89c275u, 0x78798ef4u, 0x6b3e5899u, 0xdd71b927u, 0xb64fe1beu, 0x17ad88f0u, 0x66ac20c9u, 0xb43ace7du,
+    0x184adf63u, 0x82311ae5u, 0x60335197u, 0x457f5362u, 0xe07764b1u, 0x84ae6bbbu, 0x1ca081feu, 0x942b08f9u,
+    0x58684870u, 0x19fd458fu, 0x876cde94u, 0xb7f87b52u, 0x23d373abu, 0xe2024b72u, 0x578f1fe3u, 0x2aab5566u,
+    0x0728ebb2u, 0x03c2b52fu, 0x9a7bc586u, 0xa50837d3u, 0xf2872830u, 0xb2a5bf23u, 0xba6a0302u, 0x5c8216edu,
+    0x2b1ccf8au, 0x92b479a7u, 0xf0f207f3u, 0xa1e2694eu, 0xcdf4da65u, 0xd5be0506u, 0x1f6234d1u, 0x8afea6c4u,
+    0x9d532e34u, 0xa055f3a2u, 0x32e18a05u, 0x75ebf6a4u, 0x39ec830bu, 0xaaef6040u, 0x069f715eu, 0x51106ebdu,
+    0xf98a213eu, 0x3d06dd96u, 0xae053eddu, 0x46bde64du, 0xb58d5491u, 0x055dc471u, 0x6fd40604u, 0xff155060u,
+    0x24fb9819u, 0x97e9bdd6u, 0xcc434089u, 0x779ed967u, 0xbd42e8b0u, 0x888b8907u, 0x385b19e7u, 0xdbeec879u,
+    0x470a7ca1u, 0xe90f427cu, 0xc91e84f8u, 0x00000000u, 0x83868009u, 0x48ed2b32u, 0xac70111eu, 0x4e725a6cu,
+    0xfbff0efdu, 0x5638850fu, 0x1ed5ae3du, 0x27392d36u, 0x64d90f0au, 0x21a65c68u, 0xd1545b9bu, 0x3a2e3624u,
+    0xb1670a0cu, 0x0fe75793u, 0xd296eeb4u, 0x9e919b1bu, 0x4fc5c080u, 0xa220dc61u, 0x694b775au, 0x161a121cu,
+    0x0aba93e2u, 0xe52aa0c0u, 0x43e0223cu, 0x1d171b12u, 0x0b0d090eu, 0xadc78bf2u, 0xb9a8b62du, 0xc8a91e14u,
+    0x8519f157u, 0x4c0775afu, 0xbbdd99eeu, 0xfd607fa3u, 0x9f2601f7u, 0xbcf5725cu, 0xc53b6644u, 0x347efb5bu,
+    0x7629438bu, 0xdcc623cbu, 0x68fcedb6u, 0x63f1e4b8u, 0xcadc31d7u, 0x10856342u, 0x40229713u, 0x2011c684u,
+    0x7d244a85u, 0xf83dbbd2u, 0x1132f9aeu, 0x6da129c7u, 0x4b2f9e1du, 0xf330b2dcu, 0xec52860du, 0xd0e3c177u,
+    0x6c16b32bu, 0x99b970a9u, 0xfa489411u, 0x2264e947u, 0xc48cfca8u, 0x1a3ff0a0u, 0xd82c7d56u, 0xef903322u,
+    0xc74e4987u, 0xc1d138d9u, 0xfea2ca8cu, 0x360bd498u, 0xcf81f5a6u, 0x28de7aa5u, 0x268eb7dau, 0xa4bfad3fu,
+    0xe49d3a2cu, 0x0d927850u, 0x9bcc5f6au, 0x62467e54u, 0xc2138df6u, 0xe8b8d890u, 0x5ef7392eu, 0xf5afc382u,
+    0xbe805d9fu, 0x7c93d069u, 0xa92dd56fu, 0xb31225cfu, 0x3b99acc8u, 0xa77d1810u, 0x6e639ce8u, 0x7bbb3bdbu,
+    0x097826cdu, 0xf418596eu, 0x01b79aecu, 0xa89a4f83u, 0x656e95e6u, 0x7ee6ffaau, 0x08cfbc21u, 0xe6e815efu,
+    0xd99be7bau, 0xce366f4au, 0xd4099feau, 0xd67cb029u, 0xafb2a431u, 0x31233f2au, 0x3094a5c6u, 0xc066a235u,
+    0x37bc4e74u, 0xa6ca82fcu, 0xb0d090e0u, 0x15d8a733u, 0x4a9804f1u, 0xf7daec41u, 0x0e50cd7fu, 0x2ff69117u,
+    0x8dd64d76u, 0x4db0ef43u, 0x544daaccu, 0xdf0496e4u, 0xe3b5d19eu, 0x1b886a4cu, 0xb81f2cc1u, 0x7f516546u,
+    0x04ea5e9du, 0x5d358c01u, 0x737487fau, 0x2e410bfbu, 0x5a1d67b3u, 0x52d2db92u, 0x335610e9u, 0x1347d66du,
+    0x8c61d79au, 0x7a0ca137u, 0x8e14f859u, 0x893c13ebu, 0xee27a9ceu, 0x35c961b7u, 0xede51ce1u, 0x3cb1477au,
+    0x59dfd29cu, 0x3f73f255u, 0x79ce1418u, 0xbf37c773u, 0xeacdf753u, 0x5baafd5fu, 0x146f3ddfu, 0x86db4478u,
+    0x81f3afcau, 0x3ec468b9u, 0x2c342438u, 0x5f40a3c2u, 0x72c31d16u, 0x0c25e2bcu, 0x8b493c28u, 0x41950dffu,
+    0x7101a839u, 0xdeb30c08u, 0x9ce4b4d8u, 0x90c15664u, 0x6184cb7bu, 0x70b632d5u, 0x745c6c48u, 0x4257b8d0u
+};
+#endif
+#endif // #if defined(AES_TTABLE) && (AES_TTABLE == 1)
+
 // The round constant word array, RoundConstant[i], contains the values given by 
 // x to the power (i-1) being powers of x (x is denoted as {02}) in the field GF(2^8)
 static const uint8_t RoundConstant[11] =
@@ -235,16 +331,64 @@ static void KeyExpansion(uint8_t *pRoundKey, const uint8_t *pKey)
 }
 
 
+#if defined(AES_TTABLE) && (AES_TTABLE == 1)
+// Converts the expanded key to column words, and builds the decryption round keys:
+// the encryption round keys in reverse order, with InvMixColumns applied to all but the first and last.
+static void RoundKeyToWords(AES_CTX *Ctx)
+{
+    unsigned Index;
+    uint8_t  *pByte;
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+    unsigned Round;
+    uint32_t Word;
+#endif
+
+    // In place: each word is read before it is written
+    for (Index = 0; Index < (AES_KEYEXPSIZE / 4); Index++)
+    {
+        pByte = (uint8_t *)&Ctx->RoundKey[Index];
+        Ctx->RoundKey[Index] = GET_WORD(pByte);
+    }
+
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+    for (Round = 0; Round <= CIPHER_ROUNDS; Round++)
+    {
+        for (Index = 0; Index < STATE_COLUMNS; Index++)
+        {
+            Word = Ctx->RoundKey[((CIPHER_ROUNDS - Round) * STATE_COLUMNS) + Index];
+
+            if ((Round > 0) && (Round < CIPHER_ROUNDS))
+            {
+                // TdTable applies RSBox, so undo it with SBox to get InvMixColumns alone
+                Word = TdTable[GetSBoxValue(BYTE0(Word))] ^
+                       ROTL8(TdTable[GetSBoxValue(BYTE1(Word))]) ^
+                       ROTL16(TdTable[GetSBoxValue(BYTE2(Word))]) ^
+                       ROTL24(TdTable[GetSBoxValue(BYTE3(Word))]);
+            }
+
+            Ctx->InvRoundKey[(Round * STATE_COLUMNS) + Index] = Word;
+        }
+    }
+#endif
+}
+#endif // #if defined(AES_TTABLE) && (AES_TTABLE == 1)
+
+
 void AesInitCtx(AES_CTX *Ctx, const uint8_t *pKey)
 {
+#if defined(AES_TTABLE) && (AES_TTABLE == 1)
+    KeyExpansion((uint8_t *)Ctx->RoundKey, pKey);
+    RoundKeyToWords(Ctx);
+#else
     KeyExpansion(Ctx->RoundKey, pKey);
+#endif
 }
 
 
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
 void AesInitCtxIv(AES_CTX* Ctx, const uint8_t *pKey, const uint8_t *pIv)
 {
-    KeyExpansion(Ctx->RoundKey, pKey);
+    AesInitCtx(Ctx, pKey);
     memcpy (Ctx->Iv, pIv, AES_BLOCKLEN);
 }
 
@@ -254,6 +398,7 @@ void AesCtxSetIv(AES_CTX *Ctx, const uint8_t *pIv)
 }
 #endif
 
+#if !(defined(AES_TTABLE) && (AES_TTABLE == 1))
 // This function adds the round key to state by an XOR function.
 static void AddRoundKey(uint8_t Round, state_t *pState, const uint8_t *pRoundKey)
 {
@@ -506,6 +651,98 @@ static void InvCipher(state_t *pState, const uint8_t* RoundKey)
 }
 #endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
 
+#else // #if !(defined(AES_TTABLE) && (AES_TTABLE == 1))
+
+// Cipher is the main function that encrypts the PlainText.
+// SubBytes, ShiftRows and MixColumns of a round are done together by TeTable lookups.
+static void Cipher(state_t *pState, const uint32_t *pRoundKey)
+{
+    uint8_t  *pBlock;
+    uint32_t S0, S1, S2, S3;
+    uint32_t T0, T1, T2, T3;
+    uint8_t  Round;
+
+    pBlock = (uint8_t *)pState;
+
+    // Add the First round key to the state before starting the rounds.
+    S0 = GET_WORD(&pBlock[0])  ^ pRoundKey[0];
+    S1 = GET_WORD(&pBlock[4])  ^ pRoundKey[1];
+    S2 = GET_WORD(&pBlock[8])  ^ pRoundKey[2];
+    S3 = GET_WORD(&pBlock[12]) ^ pRoundKey[3];
+
+    for (Round = 1; Round < CIPHER_ROUNDS; Round++)
+    {
+        pRoundKey += STATE_COLUMNS;
+        T0 = TeTable[BYTE0(S0)] ^ ROTL8(TeTable[BYTE1(S1)]) ^ ROTL16(TeTable[BYTE2(S2)]) ^ ROTL24(TeTable[BYTE3(S3)]) ^ pRoundKey[0];
+        T1 = TeTable[BYTE0(S1)] ^ ROTL8(TeTable[BYTE1(S2)]) ^ ROTL16(TeTable[BYTE2(S3)]) ^ ROTL24(TeTable[BYTE3(S0)]) ^ pRoundKey[1];
+        T2 = TeTable[BYTE0(S2)] ^ ROTL8(TeTable[BYTE1(S3)]) ^ ROTL16(TeTable[BYTE2(S0)]) ^ ROTL24(TeTable[BYTE3(S1)]) ^ pRoundKey[2];
+        T3 = TeTable[BYTE0(S3)] ^ ROTL8(TeTable[BYTE1(S0)]) ^ ROTL16(TeTable[BYTE2(S1)]) ^ ROTL24(TeTable[BYTE3(S2)]) ^ pRoundKey[3];
+        S0 = T0;
+        S1 = T1;
+        S2 = T2;
+        S3 = T3;
+    }
+
+    // Last one without MixColumns()
+    pRoundKey += STATE_COLUMNS;
+    T0 = ((uint32_t)SBox[BYTE0(S0)] | ((uint32_t)SBox[BYTE1(S1)] << 8) | ((uint32_t)SBox[BYTE2(S2)] << 16) | ((uint32_t)SBox[BYTE3(S3)] << 24)) ^ pRoundKey[0];
+    T1 = ((uint32_t)SBox[BYTE0(S1)] | ((uint32_t)SBox[BYTE1(S2)] << 8) | ((uint32_t)SBox[BYTE2(S3)] << 16) | ((uint32_t)SBox[BYTE3(S0)] << 24)) ^ pRoundKey[1];
+    T2 = ((uint32_t)SBox[BYTE0(S2)] | ((uint32_t)SBox[BYTE1(S3)] << 8) | ((uint32_t)SBox[BYTE2(S0)] << 16) | ((uint32_t)SBox[BYTE3(S1)] << 24)) ^ pRoundKey[2];
+    T3 = ((uint32_t)SBox[BYTE0(S3)] | ((uint32_t)SBox[BYTE1(S0)] << 8) | ((uint32_t)SBox[BYTE2(S1)] << 16) | ((uint32_t)SBox[BYTE3(S2)] << 24)) ^ pRoundKey[3];
+
+    PUT_WORD(&pBlock[0],  T0);
+    PUT_WORD(&pBlock[4],  T1);
+    PUT_WORD(&pBlock[8],  T2);
+    PUT_WORD(&pBlock[12], T3);
+}
+
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+// Equivalent inverse cipher: InvShiftRows, InvSubBytes and InvMixColumns of a round are
+// done together by TdTable lookups, using the decryption round keys (InvRoundKey).
+static void InvCipher(state_t *pState, const uint32_t *pRoundKey)
+{
+    uint8_t  *pBlock;
+    uint32_t S0, S1, S2, S3;
+    uint32_t T0, T1, T2, T3;
+    uint8_t  Round;
+
+    pBlock = (uint8_t *)pState;
+
+    // Add the First round key to the state before starting the rounds.
+    S0 = GET_WORD(&pBlock[0])  ^ pRoundKey[0];
+    S1 = GET_WORD(&pBlock[4])  ^ pRoundKey[1];
+    S2 = GET_WORD(&pBlock[8])  ^ pRoundKey[2];
+    S3 = GET_WORD(&pBlock[12]) ^ pRoundKey[3];
+
+    for (Round = 1; Round < CIPHER_ROUNDS; Round++)
+    {
+        pRoundKey += STATE_COLUMNS;
+        T0 = TdTable[BYTE0(S0)] ^ ROTL8(TdTable[BYTE1(S3)]) ^ ROTL16(TdTable[BYTE2(S2)]) ^ ROTL24(TdTable[BYTE3(S1)]) ^ pRoundKey[0];
+        T1 = TdTable[BYTE0(S1)] ^ ROTL8(TdTable[BYTE1(S0)]) ^ ROTL16(TdTable[BYTE2(S3)]) ^ ROTL24(TdTable[BYTE3(S2)]) ^ pRoundKey[1];
+        T2 = TdTable[BYTE0(S2)] ^ ROTL8(TdTable[BYTE1(S1)]) ^ ROTL16(TdTable[BYTE2(S0)]) ^ ROTL24(TdTable[BYTE3(S3)]) ^ pRoundKey[2];
+        T3 = TdTable[BYTE0(S3)] ^ ROTL8(TdTable[BYTE1(S2)]) ^ ROTL16(TdTable[BYTE2(S1)]) ^ ROTL24(TdTable[BYTE3(S0)]) ^ pRoundKey[3];
+        S0 = T0;
+        S1 = T1;
+        S2 = T2;
+        S3 = T3;
+    }
+
+    // Last round without InvMixColumn()
+    pRoundKey += STATE_COLUMNS;
+    T0 = ((uint32_t)RSBox[BYTE0(S0)] | ((uint32_t)RSBox[BYTE1(S3)] << 8) | ((uint32_t)RSBox[BYTE2(S2)] << 16) | ((uint32_t)RSBox[BYTE3(S1)] << 24)) ^ pRoundKey[0];
+    T1 = ((uint32_t)RSBox[BYTE0(S1)] | ((uint32_t)RSBox[BYTE1(S0)] << 8) | ((uint32_t)RSBox[BYTE2(S3)] << 16) | ((uint32_t)RSBox[BYTE3(S2)] << 24)) ^ pRoundKey[1];
+    T2 = ((uint32_t)RSBox[BYTE0(S2)] | ((uint32_t)RSBox[BYTE1(S1)] << 8) | ((uint32_t)RSBox[BYTE2(S0)] << 16) | ((uint32_t)RSBox[BYTE3(S3)] << 24)) ^ pRoundKey[2];
+    T3 = ((uint32_t)RSBox[BYTE0(S3)] | ((uint32_t)RSBox[BYTE1(S2)] << 8) | ((uint32_t)RSBox[BYTE2(S1)] << 16) | ((uint32_t)RSBox[BYTE3(S0)] << 24)) ^ pRoundKey[3];
+
+    PUT_WORD(&pBlock[0],  T0);
+    PUT_WORD(&pBlock[4],  T1);
+    PUT_WORD(&pBlock[8],  T2);
+    PUT_WORD(&pBlock[12], T3);
+}
+#endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+
+#endif // #if !(defined(AES_TTABLE) && (AES_TTABLE == 1))
+
 
 /*****************************************************************************/
 /* Public functions:                                                         */
@@ -521,7 +758,7 @@ void AesEcbEncrypt(const AES_CTX *Ctx, uint8_t *pBuffer)
 void AesEcbDecrypt(const AES_CTX *Ctx, uint8_t* pBuffer)
 {
     // Decrypt the PlainText with the Key using AES algorithm.
-    InvCipher((state_t*)pBuffer, Ctx->RoundKey);
+    InvCipher((state_t*)pBuffer, DECRYPT_ROUND_KEY(Ctx));
 }
 
 #endif // #if defined(ECB) && (ECB == 1)
@@ -563,7 +800,7 @@ void AesCbcDecryptBuffer(AES_CTX *Ctx, uint8_t *pBuffer, const size_t Length)
     for (Index = 0; Index < Length; Index += AES_BLOCKLEN)
     {
         memcpy(StoreNextIv, pBuffer, AES_BLOCKLEN);
-        InvCipher((state_t*)pBuffer, Ctx->RoundKey);
+        InvCipher((state_t*)pBuffer, DECRYPT_ROUND_KEY(Ctx));
         XorWithIv(pBuffer, Ctx->Iv);
         memcpy(Ctx->Iv, StoreNextIv, AES_BLOCKLEN);
         pBuffer += AES_BLOCKLEN;
@@ -614,7 +851,8 @@ void AesCtrXcryptBuffer(AES_CTX *Ctx, uint8_t *pBuffer, const size_t Length)
  * \brief   Decrypt Binary Buffer
  *
  * \details This function is used to decrypt the passed binary data 
- *          using CBC algorithm
+ *          using CBC algorithm. The key is expanded on the first call only,
+ *          later calls just set the IV.
  *           
  * \param   < None >
  *
@@ -624,6 +862,7 @@ void AesCtrXcryptBuffer(AES_CTX *Ctx, uint8_t *pBuffer, const size_t Length)
 void DecryptBinaryBuffer(uint8_t* pBinary, const uint32_t Size, bool SetIV)
 {
     static  AES_CTX Ctx;    
+    static  bool     KeyExpanded = false;
     uint8_t  paddingRequired;    
     uint8_t  DecryptIV[AES_BLOCKLEN];
         
@@ -651,7 +890,12 @@ void DecryptBinaryBuffer(uint8_t* pBinary, const uint32_t Size, bool SetIV)
            memcpy(DecryptIV,Iv,AES_BLOCKLEN);
         }
         
-        AesInitCtxIv(&Ctx, EncryptionKey, DecryptIV);        
+        if ( !KeyExpanded )
+        {
+            AesInitCtx(&Ctx, EncryptionKey);
+            KeyExpanded = true;
+        }
+        AesCtxSetIv(&Ctx, DecryptIV);
                        
         AesCbcDecryptBuffer(&Ctx, pBinary, ( Size + paddingRequired ));
         
@@ -661,6 +905,7 @@ void DecryptBinaryBuffer(uint8_t* pBinary, const uint32_t Size, bool SetIV)
 void ProcessPassphrase(uint8_t* pPhrase, AES_KEY key, AES_OPERATION AesOperation)
 {
     static AES_CTX Ctx;     
+    static AES_KEY CtxKey = AES_KEY_COUNT;     // Key expanded in Ctx
     static uint8_t *AuthenticateKey;
 
     AuthenticateKey = NULL;
@@ -674,7 +919,13 @@ void ProcessPassphrase(uint8_t* pPhrase, AES_KEY key, AES_OPERATION AesOperation
         AuthenticateKey = (uint8_t*)AuthenticateKey2;
     }
     
-    AesInitCtxIv(&Ctx, AuthenticateKey, Iv);
+    // Expand the key only when it changes
+    if ( key != CtxKey )
+    {
+        AesInitCtx(&Ctx, AuthenticateKey);
+        CtxKey = key;
+    }
+    AesCtxSetIv(&Ctx, Iv);
     
     if ( AES_OPERATION_ENCRYPT == AesOperation )
     {
@@ -24,6 +24,13 @@
   #define CTR (1u)
 #endif
 
+// AES_TTABLE selects the word oriented cipher: each round is 16 lookups in a 1KB
+// table (one each for encrypt and decrypt) instead of the byte oriented
+// SubBytes/ShiftRows/MixColumns steps. 0 selects the smaller byte oriented cipher.
+#ifndef AES_TTABLE
+  #define AES_TTABLE (1u)
+#endif
+
 #define ENCRYPT   (1u)
 #define DECRYPT   (2u)
 
@@ -63,7 +70,12 @@ typedef enum
 
 typedef struct
 {
+#if defined(AES_TTABLE) && (AES_TTABLE == 1)
+  uint32_t RoundKey[AES_KEYEXPSIZE / 4];      // Encryption round keys, one little endian word per column
+  uint32_t InvRoundKey[AES_KEYEXPSIZE / 4];   // Decryption round keys (equivalent inverse cipher)
+#else
   uint8_t RoundKey[AES_KEYEXPSIZE];
+#endif
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
   uint8_t Iv[AES_BLOCKLEN];
 #endif
@@ -623,7 +623,7 @@ static FLASH_CRCVALIDATION_STATUS ValidateFlashArea(void)
        }
        else if( FLASH_CRC_VALIDATED_GOOD == Status )
        {
-          Log(REQ,"Flash Integrity Check CRC Matched with Flash CRC");
+          Log(REQ,"Flash Integrity Check CRC Matched with Flash CRC (%d bytes in %d mS)", CrcHandle.ValidationSize, CrcHandle.ValidationTime);
        }
        else
        {
@@ -19,6 +19,12 @@ extern "C" {
  *          - Adjusting the head and tail pointers
  *          - Peeking into the buffer
  *          - Clearing the buffer
+ *          - Reading in place, via contiguous spans
+ * \n \n
+ *          A span is the contiguous run of data starting at the tail. Data is
+ *          parsed straight from a span and then popped, with no staging copy.
+ *          A span ends at the end of the buffer memory; wrapped data takes a
+ *          second span.
  *
  * \note    NOT thread safe!
  *
@@ -468,6 +474,48 @@ void CirBuffClear(CIR_BUFF *pCB)
     }  
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Gets the read span
+ *
+ * \details This function gets the contiguous data at the tail of the buffer,
+ *          so it can be used in place. The data stays in the buffer until
+ *          removed by CirBuffPop.
+ *
+ * \param   pCB - Pointer to the CirBuffer object.
+ * \param   ppDataOut - Pointer to return the pointer to the oldest data
+ *
+ * \return  uint16_t - Returns the number of contiguous data items at *ppDataOut.
+ *
+ * ========================================================================== */
+uint16_t CirBuffReadSpan(CIR_BUFF *pCB, uint8_t **ppDataOut)
+{
+    uint16_t u16SpanCount;
+
+    u16SpanCount = 0;
+
+    do
+    {
+        /* Check the pointer validity */
+        if ((NULL == pCB) || (NULL == ppDataOut))
+        {
+            break;
+        }
+
+        *ppDataOut = &(pCB->pDataBuff[pCB->u16TailPos]);
+
+        /* Data up to the head, or to the end of the buffer if wrapped */
+        u16SpanCount = CirBuffCount(pCB);
+        if (u16SpanCount > pCB->u16BuffSize - pCB->u16TailPos)
+        {
+            u16SpanCount = pCB->u16BuffSize - pCB->u16TailPos;
+        }
+
+    } while (false);
+
+    return u16SpanCount;
+}
+
 /**
  * \}   <this marks the end of the Doxygen group>
  */
@@ -59,6 +59,7 @@ extern uint16_t CirBuffPop(CIR_BUFF *pCB, uint16_t u16DataCountIn);
 extern uint16_t CirBuffCount(CIR_BUFF *pCB);
 extern uint16_t CirBuffFreeSpace(CIR_BUFF *pCB);
 extern void     CirBuffClear(CIR_BUFF *pCB);
+extern uint16_t CirBuffReadSpan(CIR_BUFF *pCB, uint8_t **ppDataOut);
 
 /**
  * \}  <If using addtogroup above>
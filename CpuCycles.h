@@ -36,6 +36,8 @@ extern "C"
 #define CPU_COUNTER_DISABLE()       ((DEMCR) &= ~(CORE_DEBUG_ENABLE_MASK))      // Disable
 #define CPU_COUNTER_RESET()         ((DWT_CYCCNT) = (CORE_DEBUG_RESET_COUNT))   // Restart counter
 #define CPU_COUNTER_READ()          ((DWT_CYCCNT)/ (120u))                      // Value in micro seconds
+#define CPU_COUNTER_READ_CYCLES()   (DWT_CYCCNT)                                // Raw cycles. Differences are wrap safe.
+#define CPU_CYCLES_TO_USEC(Cycles)  ((Cycles) / (120u))                         // Cycles to micro seconds
 
 /******************************************************************************/
 /*                             Global Type(s)                                 */
@@ -28,6 +28,10 @@ extern "C" {
 /*                             Global Define(s) (Macros)                      */
 /******************************************************************************/
 #define DoSMBusCRC8(crc8, value)   SMBusCrcTable[crc8 ^ value]
+
+/* CRC speed / memory trade off. All tables are const (flash). */
+#define CRC32_SLICE_BY             (8u)      ///< CRC32 bytes per table step: 1 (1 KB of tables), 4 (4 KB) or 8 (8 KB)
+#define CRC16_TABLE_SIZE           (256u)    ///< CRC16 and SlowCRC16 table entries: 16 (nibble steps, 32 bytes each) or 256 (byte steps, 512 bytes each)
 /******************************************************************************/
 /*                             Global Type(s)                                 */
 /******************************************************************************/
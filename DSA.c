@@ -192,19 +192,44 @@ void GetMessageHash(uint8_t *pMessage, uint32_t MessageLen,uint8_t *pHash)
  *
  * \details This function computes signature for the message passed.
  *          The signature generature process begins with generating a 32 byte hash for
- *          the message . Public and private keys are calculated using a random number
+ *          the message . The hash is then signed by ComputeHashSignature.
+ *
+ * \param   Message: pointer to the message. The public key and signature are
+ *                   appended to it, so the buffer must have room for them.
+ *          Count:   length of the message
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+int ComputeDigitalSignature(uint8_t *Message, uint16_t Count)
+{    
+    uint8_t Hash[SHA256_HASH_SIZE]; 
+
+    GetMessageHash(Message, Count, Hash);        
+
+    return ComputeHashSignature(Hash, &Message[Count]);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   ComputeHashSignature
+ *
+ * \details This function signs a 32 byte message hash, so a message hashed
+ *          piece by piece (sha256_update) can be signed once.
+ *          Public and private keys are calculated using a random number
  *          generator as seed. The last part is optional which helps in verifying the 
  *          generated signature on the handle itself.
  *
- * \param   
+ * \param   pHash:      pointer to the message hash
+ *          pSignature: pointer to the output, the public key followed by the
+ *                      signature (PUBLIC_KEY_SIZE + SIGNATURE_SIZE bytes)
  *
  * \return  None
  *
  * ========================================================================== */
-int ComputeDigitalSignature(uint8_t *Message, uint16_t Count)
+int ComputeHashSignature(const uint8_t *pHash, uint8_t *pSignature)
 {    
     const struct uECC_Curve_t *Curve;
-    uint8_t Hash[SHA256_HASH_SIZE]; 
     uint8_t PrivateKey[PRIVATE_KEY_SIZE] = {0};
     uint8_t PublicKey[PUBLIC_KEY_SIZE] = {0};    
     uint8_t Signature[SIGNATURE_SIZE] = {0};           
@@ -224,7 +249,6 @@ int ComputeDigitalSignature(uint8_t *Message, uint16_t Count)
     
     Curve = uECC_secp256k1();
     
-    GetMessageHash(Message, Count, Hash);        
     uECC_set_rng(&RandomNmGenerator);    
     
     do
@@ -234,15 +258,15 @@ int ComputeDigitalSignature(uint8_t *Message, uint16_t Count)
             Log(DBG, "uECC_make_key() failed\n");           
             break;
         }        
-        if (!uECC_sign_deterministic(PrivateKey, Hash, sizeof(Hash), &Ctx.uECC, Signature, Curve)) 
+        if (!uECC_sign_deterministic(PrivateKey, pHash, SHA256_HASH_SIZE, &Ctx.uECC, Signature, Curve)) 
         {
             Log(DBG,"uECC_sign() failed\n");
             break;
         }        
-        memcpy(&Message[Count],PublicKey, PUBLIC_KEY_SIZE);
-        memcpy(&Message[Count+PUBLIC_KEY_SIZE],Signature, SIGNATURE_SIZE);
+        memcpy(pSignature, PublicKey, PUBLIC_KEY_SIZE);
+        memcpy(&pSignature[PUBLIC_KEY_SIZE], Signature, SIGNATURE_SIZE);
         
-        if (!uECC_verify(PublicKey, Hash, sizeof(Hash), Signature, Curve)) 
+        if (!uECC_verify(PublicKey, pHash, SHA256_HASH_SIZE, Signature, Curve)) 
         {
             Log(DBG,"uECC_verify() failed\n");
             break;
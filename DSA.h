@@ -48,6 +48,7 @@ extern "C"
 /*                                   Global Function Prototype(s)                                 */
 /**************************************************************************************************/
 int ComputeDigitalSignature(uint8_t *Message, uint16_t Count);
+int ComputeHashSignature(const uint8_t *pHash, uint8_t *pSignature);
 
 /**
  * \}
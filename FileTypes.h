@@ -18,6 +18,7 @@
 
 #define FILE_TYPE_ID_MDF        (0x0010u)
 #define FILE_TYPE_ID_RDF        (0x0020u)
+#define FILE_TYPE_ID_RDF_INDEX  (0x0021u)
 #define FILE_TYPE_ID_KVF        (0x0100u)
 
 #endif
@@ -88,7 +88,7 @@ void FilterAverageInit(FILTER_AVERAGE *pFilter, int16_t  *pData, uint8_t Length)
 
         /* Initialize the filter data */
         pFilter->pData = pData;
-        memset(pFilter->pData, 0x0, pFilter->Length * 2);   /// \todo 10/07/2021 DAZ - Not correct. Should be length * sizeof(int16_t)
+        memset(pFilter->pData, 0x0, pFilter->Length * sizeof(int16_t));
 
     } while (false);
 }
@@ -116,7 +116,7 @@ void FilterAverageExcludeMinMax(FILTER_AVERAGE *pFilter)
 
     do
     {
-        if ((NULL == pFilter) || (NULL == pFilter->pData))
+        if ((NULL == pFilter) || (NULL == pFilter->pData) || (pFilter->Length <= 2))
         {
             break;
         }
@@ -39,6 +39,10 @@ extern "C"
 #define SIZE_TYPE_INT32       (16u)
 #define SIZE_TYPE_INT64       (32u)
 #define SIZE_TYPE_STRING      (KVF_STRING_VALUE_LEN*2u) 
+#define KVF_INDEX_FILES_MAX   (2u)      ///< KVF files held in the RAM index
+#define KVF_INDEX_KEYS_MAX    (32u)     ///< Key slots per indexed file. Must be a power of 2.
+#define KVF_INDEX_KEY_LEN     (24u)     ///< Longest key name held in the index (including terminator)
+#define KVF_INDEX_NAME_LEN    (48u)     ///< Longest file name that can be indexed (including terminator)
 /******************************************************************************/
 /*                             Local Type Definition(s)                       */
 /******************************************************************************/
@@ -50,6 +54,25 @@ static CRC_MODEL_16 KvfCrcModel =
   0x0000u,              // xor value
   &CRC_TblCRC16_8005[0] //Crc table pointer
 };
+
+/// RAM index entry for one key. Slot is empty when KeyName[0] is 0.
+typedef struct
+{
+    char      KeyName[KVF_INDEX_KEY_LEN];   ///< Key name
+    uint16_t  CrcKey;                       ///< Crc of key name, as stored in the file
+    uint8_t   VarType;                      ///< Object type (VAR_TYPE)
+    bool      ValueValid;                   ///< Value holds the current value
+    uint32_t  ValuePos;                     ///< File offset of the current value
+    uint32_t  Value;                        ///< Current value (types of 4 bytes or less)
+} KVF_INDEX_ENTRY;
+
+/// RAM index of one KVF file. Entries are open addressed on the key Crc.
+typedef struct
+{
+    char             FileName[KVF_INDEX_NAME_LEN];  ///< Indexed file. Empty if not in use.
+    bool             Complete;                      ///< All keys in the file are in the index
+    KVF_INDEX_ENTRY  Entry[KVF_INDEX_KEYS_MAX];     ///< Key entries
+} KVF_INDEX;
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
 /******************************************************************************/
@@ -58,10 +81,21 @@ static CRC_MODEL_16 KvfCrcModel =
 /******************************************************************************/
 // The full path to the active data directory
 CPU_CHAR DataFilePath[CLK_STR_FMT_YYYY_MM_DD_HH_MM_SS_LEN + 25];
+
+static KVF_INDEX KvfIndex[KVF_INDEX_FILES_MAX];    ///< Key indexes of recently used files
+static uint8_t   KvfIndexNext;                     ///< Next index to reuse
+static OS_EVENT  *pMutexKvfIndex = NULL;           ///< Guards KvfIndex. Created by KvfValidate.
 /******************************************************************************/
 /*                             Local Function ProtoType(s)                    */
 /******************************************************************************/
 static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE type, char *pFileName, KVF_ERROR *pError );
+static void GetValueForKey( const char *pKeyName, VAR_TYPE VarType, char *pFileName, void *pValue, uint8_t Size, KVF_ERROR *pError );
+static KVF_INDEX *KvfIndexGet( char *pFileName );
+static KVF_INDEX_ENTRY *KvfIndexFind( KVF_INDEX *pIndex, const char *pKeyName, uint16_t CrcKey );
+static KVF_INDEX *KvfIndexBuild( char *pFileName );
+static bool KvfIndexLock( void );
+static void KvfIndexUnlock( void );
+static uint8_t GetValueSize( VAR_TYPE VarType );
 static bool CompareKeyWithFile( FS_FILE *pFile, const char *pKeyName, uint16_t CrcKey );
 static void RewriteKeyValueFile( const KVF_PARAM *pParam, char *pFileName, KVF_ERROR *pError );
 static void CreateDefaultKeyValueFile( char *pFileName, const KVF_PARAM *pParam );
@@ -71,6 +105,278 @@ static void KvfBackup(char *pFileName);
 /******************************************************************************/
 /*                             Local Function(s)                              */
 /******************************************************************************/
+/* ========================================================================== */
+/**
+ * \brief   Get Value Size
+ *
+ * \details Returns the size of an object's current value if it is small enough
+ *          to be held in the index.
+ *
+ * \param   VarType - Type of object
+ *
+ * \return  uint8_t - Value size in bytes, 0 if the value is not held in the index
+ *
+ * ========================================================================== */
+static uint8_t GetValueSize( VAR_TYPE VarType )
+{
+    uint8_t Size;
+
+    switch (VarType)
+    {
+        case VAR_TYPE_BOOL:
+        case VAR_TYPE_INT8U:
+        case VAR_TYPE_INT8S:
+            Size = sizeof(uint8_t);
+            break;
+
+        case VAR_TYPE_INT16U:
+        case VAR_TYPE_INT16S:
+            Size = sizeof(uint16_t);
+            break;
+
+        case VAR_TYPE_INT32U:
+        case VAR_TYPE_INT32S:
+        case VAR_TYPE_FP32:
+        case VAR_TYPE_ENUM:
+            Size = sizeof(uint32_t);
+            break;
+
+        default:
+            Size = 0;
+            break;
+    }
+
+    return Size;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Kvf Index Lock
+ *
+ * \details Takes the index mutex. Until KvfValidate has created the mutex
+ *          the index is not used, and lookups search the file.
+ *
+ * \return  bool - true if the index may be used. KvfIndexUnlock must follow.
+ *
+ * ========================================================================== */
+static bool KvfIndexLock( void )
+{
+    uint8_t OsError;
+    bool    Locked;
+
+    Locked = false;
+
+    if (pMutexKvfIndex != NULL)
+    {
+        OSMutexPend(pMutexKvfIndex, 0, &OsError);
+        Locked = (OsError == OS_ERR_NONE);
+    }
+
+    return Locked;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Kvf Index Unlock
+ *
+ * \details Releases the index mutex taken by KvfIndexLock.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void KvfIndexUnlock( void )
+{
+    OSMutexPost(pMutexKvfIndex);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Kvf Index Get
+ *
+ * \details Returns the RAM index of the specified file, if there is one.
+ *
+ * \param   pFileName - File name
+ *
+ * \return  KVF_INDEX* - Index of the file, NULL if the file is not indexed
+ *
+ * ========================================================================== */
+static KVF_INDEX *KvfIndexGet( char *pFileName )
+{
+    KVF_INDEX *pIndex;
+    uint8_t   Indx;
+
+    pIndex = NULL;
+
+    for (Indx = 0; Indx < KVF_INDEX_FILES_MAX; Indx++)
+    {
+        if ((KvfIndex[Indx].FileName[0] != 0) && (strcmp(KvfIndex[Indx].FileName, pFileName) == 0))
+        {
+            pIndex = &KvfIndex[Indx];
+            break;
+        }
+    }
+
+    return pIndex;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Kvf Index Find
+ *
+ * \details Looks up a key in a file's RAM index. Probing starts at the slot
+ *          selected by the key Crc and stops at the first empty slot.
+ *
+ * \param   pIndex   - Index to search
+ * \param   pKeyName - Key name
+ * \param   CrcKey   - Crc of key name
+ *
+ * \return  KVF_INDEX_ENTRY* - Index entry for the key, NULL if not found
+ *
+ * ========================================================================== */
+static KVF_INDEX_ENTRY *KvfIndexFind( KVF_INDEX *pIndex, const char *pKeyName, uint16_t CrcKey )
+{
+    KVF_INDEX_ENTRY *pEntry;
+    uint16_t        Slot;
+    uint16_t        Probe;
+
+    pEntry = NULL;
+    Slot = CrcKey & (KVF_INDEX_KEYS_MAX - 1);
+
+    for (Probe = 0; Probe < KVF_INDEX_KEYS_MAX; Probe++)
+    {
+        BREAK_IF(pIndex->Entry[Slot].KeyName[0] == 0);
+
+        if ((pIndex->Entry[Slot].CrcKey == CrcKey) && (strcmp(pIndex->Entry[Slot].KeyName, pKeyName) == 0))
+        {
+            pEntry = &pIndex->Entry[Slot];
+            break;
+        }
+        Slot = (Slot + 1) & (KVF_INDEX_KEYS_MAX - 1);
+    }
+
+    return pEntry;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Kvf Index Build
+ *
+ * \details Scans a KVF file once and records the key, type, value offset and
+ *          (for types of 4 bytes or less) current value of every object. The
+ *          index is marked incomplete if a key is too long to hold or the
+ *          table fills, in which case lookups that miss still search the file.
+ *          Called with the index locked.
+ *
+ * \param   pFileName - File to index
+ *
+ * \return  KVF_INDEX* - Index of the file, NULL if the file can't be indexed
+ *
+ * ========================================================================== */
+static KVF_INDEX *KvfIndexBuild( char *pFileName )
+{
+    KVF_INDEX       *pIndex;
+    KVF_INDEX_ENTRY *pEntry;
+    FS_FILE         *pFile;
+    FS_ERR          FsError;
+    uint8_t         DescriptionLen;
+    uint8_t         KeyNameLen;
+    uint8_t         ValueSize;
+    uint8_t         RdByte;
+    uint16_t        ObjectSize;
+    uint16_t        Crc;
+    uint16_t        Slot;
+    uint16_t        Count;
+    uint32_t        ObjectPos;
+    char            KeyName[KVF_INDEX_KEY_LEN];
+
+    pIndex = NULL;
+
+    do
+    {
+        BREAK_IF(Str_Len(pFileName) >= KVF_INDEX_NAME_LEN);
+
+        pFile = FSFile_Open(pFileName, FS_FILE_ACCESS_MODE_RD, &FsError);
+        BREAK_IF(FsError != FS_ERR_NONE);
+
+        // reuse the file's index if it has one, otherwise the least recently built
+        pIndex = KvfIndexGet(pFileName);
+        if (pIndex == NULL)
+        {
+            pIndex = &KvfIndex[KvfIndexNext];
+            KvfIndexNext = (KvfIndexNext + 1) % KVF_INDEX_FILES_MAX;
+        }
+        memset(pIndex, 0, sizeof(KVF_INDEX));
+        pIndex->Complete = true;
+        Count = 0;
+
+        // move past header and description
+        FSFile_PosSet(pFile, 4, FS_FILE_ORIGIN_START, &FsError);
+        FsFileRdByte(pFile, &DescriptionLen);
+        FSFile_PosSet(pFile, DescriptionLen, FS_FILE_ORIGIN_CUR, &FsError);
+
+        while (FSFile_IsEOF(pFile, &FsError) == false)
+        {
+            // get object size and position
+            FsFileRdWord(pFile, &ObjectSize);
+            ObjectPos = FSFile_PosGet(pFile, &FsError);
+
+            FsFileRdWord(pFile, &Crc);
+            FsFileRdByte(pFile, &KeyNameLen);
+
+            // keep one slot empty so every probe sequence terminates
+            if ((KeyNameLen >= KVF_INDEX_KEY_LEN) || (Count >= (KVF_INDEX_KEYS_MAX - 1)))
+            {
+                pIndex->Complete = false;
+            }
+            else
+            {
+                FSFile_Rd(pFile, KeyName, KeyNameLen, &FsError);
+                KeyName[KeyNameLen] = 0;
+
+                // move past description, get VarType
+                FsFileRdByte(pFile, &DescriptionLen);
+                FSFile_PosSet(pFile, DescriptionLen, FS_FILE_ORIGIN_CUR, &FsError);
+                FsFileRdByte(pFile, &RdByte);
+
+                // first object with a key wins, as in a file search
+                if (KvfIndexFind(pIndex, KeyName, Crc) == NULL)
+                {
+                    Slot = Crc & (KVF_INDEX_KEYS_MAX - 1);
+                    while (pIndex->Entry[Slot].KeyName[0] != 0)
+                    {
+                        Slot = (Slot + 1) & (KVF_INDEX_KEYS_MAX - 1);
+                    }
+
+                    pEntry = &pIndex->Entry[Slot];
+                    memcpy(pEntry->KeyName, KeyName, KeyNameLen + 1);
+                    pEntry->CrcKey = Crc;
+                    pEntry->VarType = RdByte;
+                    pEntry->ValuePos = FSFile_PosGet(pFile, &FsError);
+
+                    ValueSize = GetValueSize((VAR_TYPE)RdByte);
+                    if (ValueSize > 0)
+                    {
+                        FSFile_Rd(pFile, &pEntry->Value, ValueSize, &FsError);
+                        pEntry->ValueValid = (FsError == FS_ERR_NONE);
+                    }
+                    Count++;
+                }
+            }
+
+            // skip over object data to next object
+            FSFile_PosSet(pFile, ObjectPos + ObjectSize, FS_FILE_ORIGIN_START, &FsError);
+        }
+
+        FSFile_Close(pFile, &FsError);
+
+        // index is usable once named
+        memcpy(pIndex->FileName, pFileName, Str_Len(pFileName) + 1);
+
+    } while (false);
+
+    return pIndex;
+}
+
 /* ========================================================================== */
 /**  
  * \brief    Compare Key With File
@@ -131,7 +437,9 @@ static bool CompareKeyWithFile( FS_FILE *pFile, const char *pKeyName, uint16_t C
  * \brief   Get File For Key
  *
  * \details This function will search the specified file for the
- *          specified key of the specified VarType.
+ *          specified key of the specified VarType. The key is looked up in
+ *          the file's RAM index (built on the first lookup), so the file is
+ *          only scanned if the key can't be held in the index.
  *
  * \param   *pKeyName - string containing Key to match ..
  * \param   VarType - VarType to match key Name string ..
@@ -153,6 +461,12 @@ static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE VarType, char *pFi
     EDC_ERR CrcErr;
     uint32_t ObjectPos;
     uint8_t RdByte;
+    KVF_INDEX *pIndex;
+    KVF_INDEX_ENTRY *pEntry;
+    bool Indexed;           // key found in the index
+    bool Missing;           // key known not to be in the file
+    uint8_t IndexedType;    // VarType of the indexed key
+    uint32_t ValuePos;      // value offset of the indexed key
     
     do
     {
@@ -166,15 +480,65 @@ static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE VarType, char *pFi
         // calculate Crc of key
         CrcKey = CRC_ChkSumCalc_16Bit(&KvfCrcModel, (void*)pKeyName, sizeof(char) * Str_Len(pKeyName), &CrcErr);
 
+        // look up key in the file's index
+        Indexed = false;
+        Missing = false;
+        IndexedType = 0;
+        ValuePos = 0;
+        if (KvfIndexLock())
+        {
+            pIndex = KvfIndexGet(pFileName);
+            if (pIndex == NULL)
+            {
+                pIndex = KvfIndexBuild(pFileName);
+            }
+            pEntry = (pIndex != NULL) ? KvfIndexFind(pIndex, pKeyName, CrcKey) : NULL;
+
+            if (pEntry != NULL)
+            {
+                Indexed = true;
+                IndexedType = pEntry->VarType;
+                ValuePos = pEntry->ValuePos;
+            }
+            else
+            {
+                Missing = (pIndex != NULL) && pIndex->Complete;
+            }
+            KvfIndexUnlock();
+        }
+
+        if (Missing)
+        {
+            *pError = KVF_ERR_KEY_DOES_NOT_EXIST;
+            pFile = NULL;
+            break;
+        }
+
+        if (Indexed && (IndexedType != (uint8_t)VarType))
+        {
+            *pError = KVF_ERR_KEY_TYPE_DOES_NOT_MATCH;
+            pFile = NULL;
+            break;
+        }
+
         // try to open file
         pFile = FSFile_Open(pFileName, FS_FILE_ACCESS_MODE_RD, &FsError);
         if (FsError != FS_ERR_NONE) 
         {
+            KvfIndexInvalidate(pFileName);
             *pError = KVF_ERR_FILE_DOES_NOT_EXIST;
             pFile = NULL;
             break;
         }
 
+        if (Indexed)
+        {
+            // key is indexed, go straight to its value
+            FSFile_PosSet(pFile, ValuePos, FS_FILE_ORIGIN_START, &FsError);
+            *pError = KVF_ERR_NONE;
+            break;
+        }
+
         // move past header
         FSFile_PosSet(pFile, 4, FS_FILE_ORIGIN_START, &FsError);
 
@@ -184,6 +548,7 @@ static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE VarType, char *pFi
         FSFile_PosSet(pFile, DescriptionLen, FS_FILE_ORIGIN_CUR, &FsError);
 
         // search for Key Name in file
+        *pError = KVF_ERR_KEY_DOES_NOT_EXIST;
         while (FSFile_IsEOF(pFile, &FsError) == false) 
         {
             // get object size
@@ -204,6 +569,7 @@ static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE VarType, char *pFi
                 {
                     FSFile_Close(pFile, &FsError);
                     *pError = KVF_ERR_KEY_TYPE_DOES_NOT_MATCH;                    
+                    pFile = NULL;
                     break;
                 } 
                 else 
@@ -216,7 +582,7 @@ static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE VarType, char *pFi
             // skip over object data to next object
             FSFile_PosSet(pFile, ObjectPos+ObjectSize, FS_FILE_ORIGIN_START, &FsError);      
         }
-        if (KVF_ERR_NONE != *pError)
+        if (KVF_ERR_KEY_DOES_NOT_EXIST == *pError)
         {
             // if we get here, then end of file is reached, search failed
             FSFile_Close(pFile, &FsError);
@@ -229,6 +595,78 @@ static FS_FILE *GetFileForKey( const char *pKeyName, VAR_TYPE VarType, char *pFi
     return pFile;
 }
 /* ========================================================================== */
+/**
+ * \brief   Get Value For Key
+ *
+ * \details Reads the current value of a key. Values of 4 bytes or less are
+ *          returned from the file's RAM index without touching the file.
+ *
+ * \param   *pKeyName - string containing Key to match
+ * \param   VarType - VarType to match key Name string
+ * \param   *pFileName - string containing file name to search for key
+ * \param   *pValue - Value destination. Unchanged if the key isn't found.
+ * \param   Size - Value size in bytes
+ * \param   *pError - KVF_ERR_NONE = if Value is valid,
+ *                    others defined in KVF_ERROR in kvf.h
+ *
+ * \return  None
+ * ========================================================================== */
+static void GetValueForKey( const char *pKeyName, VAR_TYPE VarType, char *pFileName, void *pValue, uint8_t Size, KVF_ERROR *pError )
+{
+    FS_FILE *pFile;
+    FS_ERR FsError;
+    EDC_ERR CrcErr;
+    uint16_t CrcKey;
+    KVF_INDEX *pIndex;
+    KVF_INDEX_ENTRY *pEntry;
+    bool Cached;
+
+    do
+    {
+        BREAK_IF(pError == (KVF_ERROR*)0);
+
+        Cached = false;
+        if (KvfIndexLock())
+        {
+            pIndex = KvfIndexGet(pFileName);
+            if (pIndex == NULL)
+            {
+                pIndex = KvfIndexBuild(pFileName);
+            }
+            if (pIndex != NULL)
+            {
+                CrcKey = CRC_ChkSumCalc_16Bit(&KvfCrcModel, (void*)pKeyName, sizeof(char) * Str_Len(pKeyName), &CrcErr);
+                pEntry = KvfIndexFind(pIndex, pKeyName, CrcKey);
+
+                if ((pEntry != NULL) && (pEntry->VarType == (uint8_t)VarType) && pEntry->ValueValid)
+                {
+                    memcpy(pValue, &pEntry->Value, Size);
+                    Cached = true;
+                }
+            }
+            KvfIndexUnlock();
+        }
+
+        if (Cached)
+        {
+            *pError = KVF_ERR_NONE;
+            break;
+        }
+
+        // not cached, read it from the file
+        pFile = GetFileForKey(pKeyName, VarType, pFileName, pError);
+        BREAK_IF(pFile == (FS_FILE*)0);
+
+        FSFile_Rd(pFile, pValue, Size, &FsError);
+        if (FsError != FS_ERR_NONE)
+        {
+            *pError = KVF_ERR_FILE_SYSTEM;
+        }
+        FSFile_Close(pFile, &FsError);
+
+    } while (false);
+}
+/* ========================================================================== */
 /**  
  * \brief   Rewrite Key Value File
  * 
@@ -453,6 +891,7 @@ static void RewriteKeyValueFile( const KVF_PARAM *pParam, char *pFileName, KVF_E
 
         // rename temp file to to new file
         FSEntry_Rename(TempFileName, pFileName, DEF_NO, &FsError);
+        KvfIndexInvalidate(pFileName);
         
     } while (false);
 }
@@ -564,6 +1003,8 @@ static void CreateDefaultKeyValueFile( char *pFileName, const KVF_PARAM *pParam
 
   do
   {
+      KvfIndexInvalidate(pFileName);
+
       // Create file
       pFile = FSFile_Open(pFileName, FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE, &FsErr);
       if (FsErr != FS_ERR_NONE) 
@@ -734,6 +1175,44 @@ void KvfBackup(char *pFileName)
       snprintf(SettingFileDest, sizeof(SettingFileDest), "%s\\%s", DataFilePath, pFileName);
    }
    FSEntry_Copy(pFileName, SettingFileDest, true, &FsError);   
+   KvfIndexInvalidate(SettingFileDest);
+}
+/* ========================================================================== */
+/**
+ * \brief   Kvf Index Invalidate
+ *
+ * \details Discards the RAM index of a KVF file. Must be called whenever a KVF
+ *          file is written, replaced or removed other than through this module.
+ *
+ * \param   pFileName - File whose index to discard. NULL discards all indexes.
+ *
+ * \return  None
+ * ========================================================================== */
+void KvfIndexInvalidate( char *pFileName )
+{
+    KVF_INDEX *pIndex;
+    uint8_t   Indx;
+
+    // no index can have been built until the lock exists
+    if (KvfIndexLock())
+    {
+        if (pFileName == NULL)
+        {
+            for (Indx = 0; Indx < KVF_INDEX_FILES_MAX; Indx++)
+            {
+                KvfIndex[Indx].FileName[0] = 0;
+            }
+        }
+        else
+        {
+            pIndex = KvfIndexGet(pFileName);
+            if (pIndex != NULL)
+            {
+                pIndex->FileName[0] = 0;
+            }
+        }
+        KvfIndexUnlock();
+    }
 }
 /* ========================================================================== */
 /**
@@ -741,6 +1220,8 @@ void KvfBackup(char *pFileName)
  *
  * \details validate device kvf. Create a new kvf if it doesnt exist.
  *          Check file parameters and update in case of a mismatch.    
+ *          Also creates the key index lock; files are indexed on their
+ *          first key lookup.
  * \param   pParam    - pointer to KVF parameter to validate.
  * \param   pFileName - string containing file name to search.
  * \param   pError    - KVF_ERR_NONE = if return Value is valid,
@@ -767,9 +1248,20 @@ void KvfValidate( const KVF_PARAM *pParam, char *pFileName, KVF_ERROR *pError )
     uint8_t RdByte;
     bool ParameterErr;    
     bool rewrite;    
+    uint8_t OsError;
     
     ParameterErr = false;
     rewrite = false;
+
+    // KVF files are validated at startup, before any key lookup
+    if (pMutexKvfIndex == NULL)
+    {
+        pMutexKvfIndex = SigMutexCreate("KVF-Index", &OsError);
+        if (pMutexKvfIndex == NULL)
+        {
+            Log(ERR, "KvfValidate: Index Mutex Create Error - %d", OsError);
+        }
+    }
     
     do
     {
@@ -1148,18 +1640,12 @@ uint8_t KvfGetDescription( char *pFileName, char *pBuf, uint8_t MaxChars, KVF_ER
  * ========================================================================== */
 bool KvfBoolForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
-  bool Value;
   uint8_t RdByte;
 
-  Value = false;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_BOOL, pFileName, pError);
-  FsFileRdByte(pFile, &RdByte);
-  Value = RdByte;
-  FSFile_Close(pFile, &FsError);
+  RdByte = 0;
+  GetValueForKey(pKeyName, VAR_TYPE_BOOL, pFileName, &RdByte, sizeof(RdByte), pError);
   
-  return (pFile == (FS_FILE*)0) ? false : Value;
+  return (RdByte != 0);
 }
 /* ========================================================================== */
 /**  
@@ -1178,16 +1664,12 @@ bool KvfBoolForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
  * ========================================================================== */
 uint8_t KvfInt8uForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint8_t Value;
 
   Value = 0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_INT8U, pFileName, pError);
-  FsFileRdByte(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_INT8U, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 /* ========================================================================== */
 /**  
@@ -1206,16 +1688,12 @@ uint8_t KvfInt8uForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError
  * ========================================================================== */
 int8_t KvfInt8sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint8_t Value;
 
   Value=0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_INT8S, pFileName, pError);
-  FsFileRdByte(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_INT8S, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 /* ========================================================================== */
@@ -1235,16 +1713,12 @@ int8_t KvfInt8sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError
  * ========================================================================== */
 uint16_t KvfInt16uForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint16_t Value;
   
   Value=0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_INT16U, pFileName, pError);
-  FsFileRdWord(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_INT16U, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 /* ========================================================================== */
@@ -1264,16 +1738,12 @@ uint16_t KvfInt16uForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pErr
  * ========================================================================== */
 int16_t KvfInt16sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint16_t Value;
 
   Value = 0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_INT16S, pFileName, pError);
-  FsFileRdWord(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_INT16S, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 /* ========================================================================== */
@@ -1293,16 +1763,12 @@ int16_t KvfInt16sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pErro
  * ========================================================================== */
 uint32_t KvfInt32uForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint32_t Value;
 
   Value=0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_INT32U, pFileName, pError);
-  FsFileRdLong(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_INT32U, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 /* ========================================================================== */
@@ -1322,16 +1788,12 @@ uint32_t KvfInt32uForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pErr
  * ========================================================================== */
 int32_t KvfInt32sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint32_t Value;
 
   Value=0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_INT32S, pFileName, pError);
-  FsFileRdLong(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_INT32S, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 /* ========================================================================== */
@@ -1351,15 +1813,11 @@ int32_t KvfInt32sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pErro
  * ========================================================================== */
 float32_t KvfFp32ForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   float32_t Value=0;
 
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_FP32, pFileName, pError);
-  FSFile_Rd(pFile, &Value, sizeof(float32_t), &FsError);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_FP32, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 /* ========================================================================== */
@@ -1418,16 +1876,12 @@ void KvfStringForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError,
  * ========================================================================== */
 uint32_t KvfEnumForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError )
 {
-  FS_FILE *pFile;
-  FS_ERR FsError;
   uint32_t Value;
 
   Value = 0;
-  pFile = GetFileForKey(pKeyName, VAR_TYPE_ENUM, pFileName, pError);
-  FsFileRdLong(pFile, &Value);
-  FSFile_Close(pFile, &FsError);
+  GetValueForKey(pKeyName, VAR_TYPE_ENUM, pFileName, &Value, sizeof(Value), pError);
   
-  return (pFile == (FS_FILE*)0) ? 0 : Value;
+  return Value;
 }
 
 
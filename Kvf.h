@@ -111,6 +111,7 @@ int32_t KvfInt32sForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pErro
 float32_t KvfFp32ForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError );
 void KvfStringForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError, char *pStrValue );
 uint32_t KvfEnumForKey( const char *pKeyName, char *pFileName, KVF_ERROR *pError );
+void KvfIndexInvalidate( char *pFileName );
 
 
 /**
@@ -94,6 +94,9 @@ extern "C"
 #define DISP_HEIGHT                          (96u)
 
 #define BITS_PER_PIXEL                       (16u)      // No of bits used for representing a pixel.
+#define BYTES_PER_PIXEL                      (2u)       // No of bytes used for a pixel in the memory device.
+#define BMP_CACHE_PIXELS                     (4096u)    // Bitmap cache size in pixels (8 KB).
+#define BMP_CACHE_ENTRIES                    (8u)       // Maximum number of bitmaps in the cache.
 #define MIN_RW_BYTES                         (1u)       // define for 1 byte, used while read/write of 1 byte.
 #define MAX_RW_BYTES                         (255u)
 
@@ -142,6 +145,16 @@ extern "C"
 /******************************************************************************/
 typedef int64_t   DISP_MEMDEV_HANDLE;               ///< Memory Handle used for drawing operations.
 
+typedef struct 
+{                                   /// Decoded bitmap held in the bitmap cache.
+    const uint8_t *pData;           ///< Encoded bitmap the pixels were decoded from.
+    uint8_t  Width;                 ///< Width of the bitmap.
+    uint8_t  Height;                ///< Height of the bitmap.
+    DISP_BITMAP_DRAW_METHOD DrawMethod;  ///< Method the bitmap was decoded with.
+    uint16_t Offset;                ///< Start of the decoded pixels in the cache pool.
+    uint32_t LastUse;               ///< Use stamp for least recently used eviction.
+} BMP_CACHE_ENTRY;
+
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
 /******************************************************************************/
@@ -151,6 +164,20 @@ typedef int64_t   DISP_MEMDEV_HANDLE;               ///< Memory Handle used for
 /******************************************************************************/
 static DISP_MEMDEV_HANDLE L3DispMemdevice;          ///< Variable used to hold the memory handle used for drawing on the display.
 static bool DispPortInitialized = false;           ///< Flag to indicate if Display is initialized
+static uint32_t L3DispCopyCount = 0;               ///< Number of full memory device copies to the display
+static DISP_RECT DispClipRect;                     ///< Current clip rectangle, valid if DispClipActive
+static bool DispClipActive = false;                ///< Flag to indicate drawing is limited to DispClipRect
+
+#ifdef DISP_BITMAP_CACHE
+/* Decoded pixels of the cached bitmaps. Entries are kept in pool order and packed from the
+   start of the pool, so that the free space is always at the end. */
+static uint16_t BmpCachePool[BMP_CACHE_PIXELS];
+static BMP_CACHE_ENTRY BmpCache[BMP_CACHE_ENTRIES];
+static uint8_t BmpCacheCount = 0;                  ///< Number of bitmaps in the cache
+static uint16_t BmpCacheUsed = 0;                  ///< Pixels of the pool in use
+static uint32_t BmpCacheStamp = 0;                 ///< Use stamp of the last cache access
+static Disp_BitmapCacheStats BmpCacheStats;        ///< Cache statistics
+#endif
 static BITMAP *Welcome_Screen[10] =
 {
     (BITMAP*) _animinwc01, 
@@ -171,6 +198,12 @@ static GUI_WIDGET_IMAGE WelcomeImage;                     ///< Welcome Static Im
 /******************************************************************************/
 static void DispPortClearRAM(void);
 static DISP_PORT_STATUS L3_DispPortInit(DISP_INIT_MODE InitMode);
+#ifdef DISP_BITMAP_CACHE
+static BMP_CACHE_ENTRY *DispBmpCacheFind(const Disp_Bitmap *pDispBmp);
+static void DispBmpCacheEvict(void);
+static void DispBmpCacheAdd(const Disp_Bitmap *pDispBmp, int32_t X, int32_t Y);
+static void DispBmpCacheDraw(const Disp_Bitmap *pDispBmp, const GUI_BITMAP *pGuiBmp, int32_t X, int32_t Y);
+#endif
 
 /******************************************************************************/
 /*                             Local Function(s)                              */
@@ -600,6 +633,219 @@ DISP_PORT_STATUS L3_WelcomeStaticScreen(uint8_t ScreenNo)
     return DISP_PORT_STATUS_OK;
 }
 
+#ifdef DISP_BITMAP_CACHE
+/* ========================================================================== */
+/**
+ * \brief   Finds a bitmap in the bitmap cache.
+ *
+ * \details A cached bitmap matches if it was decoded from the same image data,
+ *          with the same size and draw method.
+ *
+ * \param   pDispBmp - Pointer to the bitmap to find.
+ *
+ * \return  BMP_CACHE_ENTRY - Cache entry of the bitmap, NULL if not cached.
+ *
+ * ========================================================================== */
+static BMP_CACHE_ENTRY *DispBmpCacheFind(const Disp_Bitmap *pDispBmp)
+{
+    BMP_CACHE_ENTRY *pEntry;
+    uint8_t Index;
+
+    pEntry = NULL;
+
+    for (Index = 0; Index < BmpCacheCount; Index++)
+    {
+        if ((BmpCache[Index].pData == pDispBmp->pData) &&
+            (BmpCache[Index].Width == pDispBmp->Width) &&
+            (BmpCache[Index].Height == pDispBmp->Height) &&
+            (BmpCache[Index].DrawMethod == pDispBmp->DrawMethod))
+        {
+            pEntry = &BmpCache[Index];
+            break;
+        }
+    }
+
+    return pEntry;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Removes the least recently used bitmap from the bitmap cache.
+ *
+ * \details The pixels of the bitmaps after it are moved down the pool, to keep
+ *          the free space at the end of the pool.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void DispBmpCacheEvict(void)
+{
+    uint8_t Index;
+    uint8_t Oldest;
+    uint16_t Size;
+
+    do
+    {
+        BREAK_IF(0 == BmpCacheCount);
+
+        Oldest = 0;
+        for (Index = 1; Index < BmpCacheCount; Index++)
+        {
+            if ((BmpCacheStamp - BmpCache[Index].LastUse) > (BmpCacheStamp - BmpCache[Oldest].LastUse))
+            {
+                Oldest = Index;
+            }
+        }
+
+        Size = (uint16_t)(BmpCache[Oldest].Width * BmpCache[Oldest].Height);
+        memmove(&BmpCachePool[BmpCache[Oldest].Offset],
+                &BmpCachePool[BmpCache[Oldest].Offset + Size],
+                (BmpCacheUsed - BmpCache[Oldest].Offset - Size) * BYTES_PER_PIXEL);
+
+        for (Index = Oldest; Index < (BmpCacheCount - 1); Index++)
+        {
+            BmpCache[Index] = BmpCache[Index + 1];
+            BmpCache[Index].Offset -= Size;
+        }
+
+        BmpCacheCount--;
+        BmpCacheUsed -= Size;
+        BmpCacheStats.Evictions++;
+
+    } while (false);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Adds a bitmap just drawn to the bitmap cache.
+ *
+ * \details The decoded pixels are copied from the memory device. Bitmaps that
+ *          were not drawn in full (outside the display or the clip rectangle)
+ *          and bitmaps larger than the cache are not added. Least recently
+ *          used bitmaps are removed to make room.
+ *
+ * \param   pDispBmp - Pointer to the bitmap drawn.
+ * \param   X - X-position of the upper left corner of the bitmap in the display.
+ * \param   Y - Y-position of the upper left corner of the bitmap in the display.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void DispBmpCacheAdd(const Disp_Bitmap *pDispBmp, int32_t X, int32_t Y)
+{
+    BMP_CACHE_ENTRY *pEntry;
+    uint16_t *pPixels;
+    uint16_t Size;
+    uint8_t Row;
+
+    do
+    {
+        Size = (uint16_t)(pDispBmp->Width * pDispBmp->Height);
+        BREAK_IF((0 == Size) || (Size > BMP_CACHE_PIXELS));
+
+        /* Only the whole bitmap can be copied back */
+        BREAK_IF((X < 0) || (Y < 0) ||
+                 ((X + pDispBmp->Width) > (int32_t)DISP_WIDTH) || ((Y + pDispBmp->Height) > (int32_t)DISP_HEIGHT));
+        BREAK_IF(DispClipActive &&
+                 ((X < DispClipRect.x0) || (Y < DispClipRect.y0) ||
+                  ((X + pDispBmp->Width - 1) > DispClipRect.x1) || ((Y + pDispBmp->Height - 1) > DispClipRect.y1)));
+
+        pPixels = (uint16_t *)GUI_MEMDEV_GetDataPtr(L3DispMemdevice);
+        BREAK_IF(NULL == pPixels);
+
+        while ((BmpCacheCount >= BMP_CACHE_ENTRIES) || ((BmpCacheUsed + Size) > BMP_CACHE_PIXELS))
+        {
+            DispBmpCacheEvict();
+        }
+
+        pEntry = &BmpCache[BmpCacheCount];
+        pEntry->pData = pDispBmp->pData;
+        pEntry->Width = pDispBmp->Width;
+        pEntry->Height = pDispBmp->Height;
+        pEntry->DrawMethod = pDispBmp->DrawMethod;
+        pEntry->Offset = BmpCacheUsed;
+        pEntry->LastUse = BmpCacheStamp;
+
+        for (Row = 0; Row < pDispBmp->Height; Row++)
+        {
+            memcpy(&BmpCachePool[pEntry->Offset + (Row * pDispBmp->Width)],
+                   &pPixels[((Y + Row) * DISP_WIDTH) + X],
+                   pDispBmp->Width * BYTES_PER_PIXEL);
+        }
+
+        BmpCacheCount++;
+        BmpCacheUsed += Size;
+
+    } while (false);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Draws a bitmap through the bitmap cache.
+ *
+ * \details A cached bitmap is drawn from its decoded pixels. Otherwise the
+ *          bitmap is decoded and drawn by the Micrium API, and then added to
+ *          the cache if it has no transparent pixels (RLE16, RLEM16).
+ *
+ * \param   pDispBmp - Pointer to the bitmap to display.
+ * \param   pGuiBmp - Pointer to the Micrium bitmap to draw on a cache miss.
+ * \param   X - X-position of the upper left corner of the bitmap in the display.
+ * \param   Y - Y-position of the upper left corner of the bitmap in the display.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void DispBmpCacheDraw(const Disp_Bitmap *pDispBmp, const GUI_BITMAP *pGuiBmp, int32_t X, int32_t Y)
+{
+    BMP_CACHE_ENTRY *pEntry;
+    GUI_BITMAP CacheBmp;
+    uint32_t StartCycles;
+    uint32_t Elapsed;
+
+    GUI_Lock();
+
+    StartCycles = CPU_COUNTER_READ_CYCLES();
+    BmpCacheStamp++;
+
+    pEntry = DispBmpCacheFind(pDispBmp);
+    if (NULL != pEntry)
+    {
+        pEntry->LastUse = BmpCacheStamp;
+
+        CacheBmp.XSize = pEntry->Width;
+        CacheBmp.YSize = pEntry->Height;
+        CacheBmp.BytesPerLine = pEntry->Width * BYTES_PER_PIXEL;
+        CacheBmp.BitsPerPixel = BITS_PER_PIXEL;
+        CacheBmp.pData = (const uint8_t *)&BmpCachePool[pEntry->Offset];
+        CacheBmp.pPal = NULL;
+        CacheBmp.pMethods = GUI_DRAW_BMP565;
+        GUI_DrawBitmap(&CacheBmp, X, Y);
+
+        BmpCacheStats.Hits++;
+        BmpCacheStats.HitTime += CPU_CYCLES_TO_USEC(CPU_COUNTER_READ_CYCLES() - StartCycles);
+    }
+    else
+    {
+        GUI_DrawBitmap(pGuiBmp, X, Y);
+
+        Elapsed = CPU_CYCLES_TO_USEC(CPU_COUNTER_READ_CYCLES() - StartCycles);
+        BmpCacheStats.Misses++;
+        BmpCacheStats.DecodeTime += Elapsed;
+        BmpCacheStats.DecodeTimeMax = (Elapsed > BmpCacheStats.DecodeTimeMax) ? Elapsed : BmpCacheStats.DecodeTimeMax;
+
+        if ((DISP_BITMAP_DRAW_METHOD_RLE16 == pDispBmp->DrawMethod) ||
+            (DISP_BITMAP_DRAW_METHOD_RLEM16 == pDispBmp->DrawMethod))
+        {
+            DispBmpCacheAdd(pDispBmp, X, Y);
+        }
+    }
+
+    GUI_Unlock();
+}
+#endif
+
 /******************************************************************************/
 /*                             Global Function(s)                             */
 /******************************************************************************/
@@ -1036,10 +1282,42 @@ void L3_DispDrawBitmap(Disp_Bitmap *pDispBmp, int8_t X, int8_t Y)
                  break;  
         }   
 
+#ifdef DISP_BITMAP_CACHE
+        DispBmpCacheDraw(pDispBmp, &GuiBmp, (int32_t)X, (int32_t)Y);
+#else
         GUI_DrawBitmap(&GuiBmp, (int32_t)X, (int32_t)Y);
+#endif
     } /* else not needed */
 }
 
+/* ========================================================================== */
+/**
+ * \brief   This function gets the bitmap cache statistics.
+ *
+ * \details The hit count and decode times show how much flash decompression
+ *          the cache saves; the byte counts show its RAM cost.
+ *
+ * \param   pStats - Pointer to return the statistics.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_DispBitmapCacheStatsGet(Disp_BitmapCacheStats *pStats)
+{
+    if (NULL != pStats)
+    {
+#ifdef DISP_BITMAP_CACHE
+        GUI_Lock();
+        BmpCacheStats.BytesUsed = BmpCacheUsed * BYTES_PER_PIXEL;
+        BmpCacheStats.BytesTotal = sizeof(BmpCachePool);
+        *pStats = BmpCacheStats;
+        GUI_Unlock();
+#else
+        memset(pStats, 0, sizeof(Disp_BitmapCacheStats));
+#endif
+    }
+}
+
 /* ========================================================================== */
 /**
  * \brief   This function draws the borders of a Rectangle defined by its sides 
@@ -1254,6 +1532,129 @@ void L3_DispRectFillColor(uint32_t Color, int8_t X1, int8_t X2, int8_t Y1, int8_
 void L3_DispMemDevCopyToLCD(void)
 {
     GUI_MEMDEV_CopyToLCD(L3DispMemdevice);
+    L3DispCopyCount++;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   This function copies a rectangle of the memory device to the OLED
+ *          Display.
+ *
+ * \details The rectangle is drawn on the display as a 565 bitmap read in place
+ *          from the memory device pixels, so only the pixels in the rectangle
+ *          are sent to the display.
+ *
+ * \param   pRect - Rectangle to copy (inclusive coordinates)
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_DispMemDevCopyRectToLCD(const DISP_RECT *pRect)
+{
+    GUI_BITMAP MemDevBmp;
+    uint8_t    *pPixels;
+    int32_t    X0;
+    int32_t    Y0;
+    int32_t    X1;
+    int32_t    Y1;
+
+    do
+    {
+        BREAK_IF(NULL == pRect);
+
+        /* Clip to the display */
+        X0 = (pRect->x0 < 0) ? 0 : pRect->x0;
+        Y0 = (pRect->y0 < 0) ? 0 : pRect->y0;
+        X1 = (pRect->x1 >= (int32_t)DISP_WIDTH) ? ((int32_t)DISP_WIDTH - 1) : pRect->x1;
+        Y1 = (pRect->y1 >= (int32_t)DISP_HEIGHT) ? ((int32_t)DISP_HEIGHT - 1) : pRect->y1;
+        BREAK_IF((X1 < X0) || (Y1 < Y0));
+
+        pPixels = (uint8_t *)GUI_MEMDEV_GetDataPtr(L3DispMemdevice);
+        BREAK_IF(NULL == pPixels);
+
+        MemDevBmp.XSize = (uint16_t)(X1 - X0 + 1);
+        MemDevBmp.YSize = (uint16_t)(Y1 - Y0 + 1);
+        MemDevBmp.BytesPerLine = DISP_WIDTH * BYTES_PER_PIXEL;
+        MemDevBmp.BitsPerPixel = BITS_PER_PIXEL;
+        MemDevBmp.pData = &pPixels[(Y0 * DISP_WIDTH * BYTES_PER_PIXEL) + (X0 * BYTES_PER_PIXEL)];
+        MemDevBmp.pPal = NULL;
+        MemDevBmp.pMethods = GUI_DRAW_BMP565;
+
+        /* Draw on the display, then return to the memory device */
+        (void)GUI_MEMDEV_Select(0);
+        GUI_DrawBitmap(&MemDevBmp, X0, Y0);
+        (void)GUI_MEMDEV_Select(L3DispMemdevice);
+
+    } while (false);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   This function gets the number of full memory device copies to the
+ *          OLED Display.
+ *
+ * \details A change in the count shows the display was updated in full (eg:
+ *          by a screen drawn outside the display manager) since last checked.
+ *
+ * \param   < None >
+ *
+ * \return  uint32_t - Number of L3_DispMemDevCopyToLCD calls
+ *
+ * ========================================================================== */
+uint32_t L3_DispMemDevCopyCount(void)
+{
+    return L3DispCopyCount;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   This function sets the clip rectangle for drawing operations.
+ *
+ * \details This is wrapper function which internally calls the Micrium API
+ *          to limit further drawing operations to a rectangle.
+ *
+ * \param   pRect - Rectangle to draw in (inclusive coordinates). NULL to draw anywhere.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_DispSetClipRect(const DISP_RECT *pRect)
+{
+    DispClipActive = (NULL != pRect);
+    if (DispClipActive)
+    {
+        DispClipRect = *pRect;
+    }
+    (void)GUI_SetClipRect(DispClipActive ? &DispClipRect : NULL);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   This function gets the rectangle covered by a string.
+ *
+ * \details The rectangle is the area L3_DispStringAtXY draws for the string,
+ *          including the background of each character.
+ *
+ * \param   Font - Font to be used for displaying the string.
+ * \param   X - X-position to display string.
+ * \param   Y - Y-position to display string.
+ * \param   pString - pointer to String to display
+ * \param   pRect - pointer to return the rectangle (inclusive coordinates)
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_DispGetStringRect(FONT_TYPE Font, int8_t X, int8_t Y, const int8_t *pString, DISP_RECT *pRect)
+{
+    if ((NULL != pString) && (NULL != pRect))
+    {
+        L3_DispSetFont(Font);
+
+        pRect->x0 = X;
+        pRect->y0 = Y;
+        pRect->x1 = X + GUI_GetStringDistX((const char *)pString) - 1;
+        pRect->y1 = Y + GUI_GetFontDistY() - 1;
+    }
 }
 
 /* ========================================================================== */
@@ -50,6 +50,10 @@ extern "C"
 #define DISPXPOS  (0u)
 #define DISPYPOS  (96u)
 
+/* With DISP_BITMAP_CACHE defined, RLE bitmaps are kept decoded in RAM once drawn, so that
+   animations repeating the same images are not decompressed from flash on every frame. */
+#define DISP_BITMAP_CACHE
+
 /******************************************************************************/
 /*                             Global Type(s)                                 */
 /******************************************************************************/
@@ -166,6 +170,18 @@ typedef struct
     uint16_t               BitmapCount;            ///< Number of bitmaps to be used in Animation.
 } Disp_Animation;
 
+typedef struct 
+{                                   /// Bitmap cache statistics, for profiling.
+    uint32_t Hits;                  ///< Bitmaps drawn from the cache.
+    uint32_t Misses;                ///< Bitmaps decoded from flash.
+    uint32_t Evictions;             ///< Bitmaps removed from the cache to make room.
+    uint32_t BytesUsed;             ///< Cache RAM holding decoded bitmaps.
+    uint32_t BytesTotal;            ///< Cache RAM size.
+    uint32_t DecodeTime;            ///< Time spent decoding bitmaps (uS).
+    uint32_t DecodeTimeMax;         ///< Longest bitmap decode (uS).
+    uint32_t HitTime;               ///< Time spent drawing bitmaps from the cache (uS).
+} Disp_BitmapCacheStats;
+
 /******************************************************************************/
 /*                             Global Constant Declaration(s)                 */
 /******************************************************************************/
@@ -205,6 +221,7 @@ extern void L3_DispClearRect(int8_t X1, int8_t Y1, int8_t X2, int8_t Y2);
 extern void L3_DispDrawCircle(int8_t X1, int8_t Y1, int8_t Radius);
 extern void L3_DispFillCircle(int8_t X1, int8_t Y1, int8_t Radius);
 extern void L3_DispDrawBitmap( Disp_Bitmap *pDispBmp, int8_t X, int8_t Y);
+extern void L3_DispBitmapCacheStatsGet(Disp_BitmapCacheStats *pStats);
 extern void L3_DispDrawRectBorders(uint32_t Color, int8_t X, int8_t Y, int8_t BorderWidth, int8_t XLength, int8_t YLength);
 extern void L3_DispDrawBattery(uint32_t Color, DISP_BAT_LEVEL Level);
 extern void L3_DispDrawArrow(uint32_t Color, int8_t X, int8_t Y, DISP_POINT *pDispPoint);
@@ -213,6 +230,10 @@ extern void L3_DispStringAtXY(FONT_TYPE Font, uint32_t FgColor, uint32_t BkColor
 extern void L3_DispRectFillColor(uint32_t Color, int8_t X1, int8_t X2, int8_t Y1, int8_t Y2);
 extern void L3_DispDrawAnimation(Disp_Animation *pAnimation);
 extern void L3_DispMemDevCopyToLCD(void);
+extern void L3_DispMemDevCopyRectToLCD(const DISP_RECT *pRect);
+extern uint32_t L3_DispMemDevCopyCount(void);
+extern void L3_DispSetClipRect(const DISP_RECT *pRect);
+extern void L3_DispGetStringRect(FONT_TYPE Font, int8_t X, int8_t Y, const int8_t *pString, DISP_RECT *pRect);
 extern void L3_DisplayOn(bool DisplayIsOn);
 extern DISP_PORT_STATUS L3_WelcomeStaticScreen(uint8_t ScreenNo);
 
@@ -107,6 +107,9 @@ typedef struct          ///< The fpga register data for DMA transfers to the FPG
     uint16_t ReadCRC;   ///< CRC of data for read request is saved here, sent to FPGA as last 2 bytes of the packet.
     uint16_t WriteCRC;  ///< CRC of data for write request is saved here, sent to FPGA as last 2 bytes of the packet.
     uint8_t  CrcError;  ///< This count is incremented at each register transfer failure, and cleared when transfer is successful
+    uint8_t  WriteGen;  ///< Bumped each time a new value is written to the shadow register
+    uint8_t  SentGen;   ///< WriteGen of the value in the write packet in flight
+    bool     InSync;    ///< Shadow value matches the FPGA (write acknowledged or read back). Unchanged writes are not sent.
 } FPGA_REG_DYNAMIC;
 
 /* ERROR CODES FOR FPGA COM TEST */
@@ -141,6 +144,16 @@ typedef struct                              ///< FPGA error log entry
     uint32_t TimerError;                    ///< Timer error
 } FPGA_ERROR_REC;
 
+/* FPGA link traffic statistics */
+typedef struct
+{
+    uint32_t Cycles;                        ///< Controller cycles with an SPI transfer
+    uint32_t RdBytes;                       ///< Total read data set bytes
+    uint32_t WrBytes;                       ///< Total write data set bytes
+    uint16_t MaxRdBytes;                    ///< Largest read data set in one cycle
+    uint16_t MaxWrBytes;                    ///< Largest write data set in one cycle
+} FPGA_LINK_STATS;
+
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
 /******************************************************************************/
@@ -229,6 +242,7 @@ static FPGA_REG_DYNAMIC FpgaDynamicMap[FPGA_REG_COUNT];     /* FPGA shadow regis
 //#pragma location=".sram"
 static FPGA_ERROR_REC FpgaErrorLog[FPGA_MAX_ERR_LOG];       /* FPGA error log register */
 static uint8_t  FpgaErrorCount = 0;                         /* FPGA error count */
+static FPGA_LINK_STATS FpgaLinkStats;                       /* FPGA link traffic statistics */
 
 /******************************************************************************/
 /*                             Local Function Prototype(s)                    */
@@ -326,6 +340,10 @@ static bool FpgaStartReadDataSet(void)
         SpiPacket.Nbytes     = SpiBufIdx;
         SpiPacket.pCallback  = &FpgaReadDoneEvent;
         L2_SpiDataIO(&SpiPacket);
+
+        FpgaLinkStats.Cycles++;
+        FpgaLinkStats.RdBytes += SpiBufIdx;
+        FpgaLinkStats.MaxRdBytes = MAX(FpgaLinkStats.MaxRdBytes, SpiBufIdx);
     }
 
     return (SpiBufIdx > 0);     // Return true if DMA transfer started
@@ -371,6 +389,7 @@ static bool FpgaStartWriteDataSet(void)
         if (FpgaDynamicMap[Idx].WriteRequest == true)
         {
             RegWrTxPkts++;                                  /* Bump packet count */
+            FpgaDynamicMap[Idx].SentGen = FpgaDynamicMap[Idx].WriteGen;    /* Value generation being sent */
             DataType = IdxToAdr[Idx].Adr;                   /* Get register address */
             pReg = (uint8_t *)&FpgaDynamicMap[Idx].Val8;    /* Get pointer to register data */
             DataSize = IdxToAdr[Idx].RegSize;               /* Get register data size */
@@ -416,6 +435,9 @@ static bool FpgaStartWriteDataSet(void)
         SpiPacket.Nbytes     = SpiBufIdx;
         SpiPacket.pCallback  = &FpgaWriteDoneEvent;
         L2_SpiDataIO(&SpiPacket);
+
+        FpgaLinkStats.WrBytes += SpiBufIdx;
+        FpgaLinkStats.MaxWrBytes = MAX(FpgaLinkStats.MaxWrBytes, SpiBufIdx);
     }
 
     return (SpiBufIdx > 0); // Return true if DMA transfer started
@@ -504,15 +526,21 @@ static bool FpgaProcessReadDataSet(void)
         Crc |= FpgaRxBuffer[SpiBufIdx++];
         CalcCRC = CRC_ChkSumCalc_16Bit((CRC_MODEL_16 *)&CrcModel, &FpgaRxBuffer[StartOfDataIdx], (DataSize + 1), &Err); /* Calc CRC of addr & data */
 
+        TM_Hook(HOOK_FPGACRCFAIL, &CalcCRC);                             /* Test hook: corrupt the CRC to exercise the error path */
+
         if (Crc == CalcCRC && (false == FpgaResponseOutOfSync))
         {
             /* CRC OK. Extract data - switch endian-ness when copying */
             FpgaDynamicMap[Idx].ReadRequest = false;                   /* Read request has been processed */
             FpgaDynamicMap[Idx].CrcError = 0;                          /* Clear error count for good crc */
-            uint8_t *pReg = (uint8_t *)&FpgaDynamicMap[Idx].Val8;
-            for (uint8_t j = DataSize; j > 0; j--)
+            if (!FpgaDynamicMap[Idx].WriteRequest)                     /* Do not overwrite a value written during the transfer */
             {
-                *pReg++ = FpgaRxBuffer[DataOffset + j - 1];
+                FpgaDynamicMap[Idx].InSync = true;                     /* Shadow holds the FPGA value */
+                uint8_t *pReg = (uint8_t *)&FpgaDynamicMap[Idx].Val8;
+                for (uint8_t j = DataSize; j > 0; j--)
+                {
+                    *pReg++ = FpgaRxBuffer[DataOffset + j - 1];
+                }
             }
         }
         else /* Some kind of error in data set read. Log error:  */
@@ -633,7 +661,12 @@ static bool FPGA_ProcessWriteDataSet(void)
         {
             if ((FPGA_SPI_WR_ACK == FpgaRxBuffer[SpiBufIdx]) && (!FpgaResponseOutOfSync))
             {
-                FpgaDynamicMap[Idx].WriteRequest = false;          /* Packet succeeded - mark register as written */
+                /* Packet succeeded - mark register as written, unless a newer value was written while the packet was in flight */
+                if (FpgaDynamicMap[Idx].SentGen == FpgaDynamicMap[Idx].WriteGen)
+                {
+                    FpgaDynamicMap[Idx].WriteRequest = false;
+                    FpgaDynamicMap[Idx].InSync = true;
+                }
             }
             else
             {
@@ -843,7 +876,7 @@ void FpgaWriteDoneEvent(void)
 /**
  * \brief   Clear FPGA error log
  *
- * \details Clears FPGA error log, resets log entry index
+ * \details Clears FPGA error log, resets log entry index and link statistics
  *
  * \param  < None >
  *
@@ -866,6 +899,7 @@ void L3_FpgaErrorLogClear(void)
         FpgaErrorLog[Index].TotalWrAckErrors = 0;
         FpgaErrorLog[Index].TotalCrcErrors = 0;
     }
+    memset(&FpgaLinkStats, 0, sizeof(FpgaLinkStats));
     Log(TRC, "FPGA Error log cleared: %d", Index);
 }
 
@@ -873,7 +907,8 @@ void L3_FpgaErrorLogClear(void)
 /**
  * \brief   Dump FPGA error log
  *
- * \details Dumps and clear all FPGA error log entries, resets log entry index
+ * \details Dumps and clear all FPGA error log entries, resets log entry index.
+ *          Also dumps the FPGA link traffic statistics.
  *
  * \param  < None >
  *
@@ -902,6 +937,9 @@ void L3_FpgaErrorLogDump(void)
     {
         Log(TRC, "FPGA Error log is empty");
     }
+
+    Log(TRC, "FPGA Link: Cycles: %d, Rd Bytes: %d (Max %d), Wr Bytes: %d (Max %d)",
+            FpgaLinkStats.Cycles, FpgaLinkStats.RdBytes, FpgaLinkStats.MaxRdBytes, FpgaLinkStats.WrBytes, FpgaLinkStats.MaxWrBytes);
 }
 
 /* ========================================================================== */
@@ -1085,7 +1123,8 @@ bool L3_FpgaReadReg(FPGA_REG Reg, uint32_t *pRegVal)
  * \brief   Writes an FPGA Register
  *
  * \details Sets the FPGA shadow register. The FPGA_Controller_Task will complete
- *          the pending write as part of the task loop.
+ *          the pending write as part of the task loop. A write of the value the
+ *          FPGA is already known to hold is not sent.
  *
  * \note    If the register to be written is smaller than 32 bits (ie. 8, 16 bit),
  *          only the least significant bits of the register will be written. Higher
@@ -1101,6 +1140,7 @@ bool L3_FpgaWriteReg(FPGA_REG Reg, uint32_t RegVal)
 {
     bool    ErrorStatus;        /* Function error status. True if error. */
     uint8_t Idx;                /* Index into IdxToAdr for register */
+    bool    Changed;            /* True if RegVal differs from the shadow register */
 
     ErrorStatus = false;
     Idx = (uint8_t)Reg;
@@ -1119,23 +1159,31 @@ bool L3_FpgaWriteReg(FPGA_REG Reg, uint32_t RegVal)
         switch (IdxToAdr[Idx].RegSize)
         {
             case REG_BYTE:
+                Changed = (FpgaDynamicMap[Idx].Val8 != (uint8_t)RegVal);
                 FpgaDynamicMap[Idx].Val8 = (uint8_t)RegVal;
                 break;
 
             case REG_WORD:
+                Changed = (FpgaDynamicMap[Idx].Val16 != (uint16_t)RegVal);
                 FpgaDynamicMap[Idx].Val16 = (uint16_t)RegVal;
                 break;
 
             case REG_LONG:
+                Changed = (FpgaDynamicMap[Idx].Val32 != RegVal);
                 FpgaDynamicMap[Idx].Val32 = RegVal;
                 break;
 
             default:
                 Log(DBG, "L3_Fpga: Error in L3_FpgaWriteReg() Size: RegVal = %d", RegVal);
+                Changed = true;
                 ErrorStatus = true;
                 break;
         }
 
+        /* Nothing to send if the FPGA already holds this value and no write is pending */
+        BREAK_IF(!Changed && FpgaDynamicMap[Idx].InSync && !FpgaDynamicMap[Idx].WriteRequest);
+
+        FpgaDynamicMap[Idx].WriteGen++;          /* New value - an in-flight write of the old value does not complete the request */
         FpgaDynamicMap[Idx].WriteRequest = true; /* Schedule write request */
 
     } while (false);
@@ -1186,8 +1234,9 @@ bool L3_FpgaIsRefreshPending(void)
  * \details After an FPGA refresh, certain FPGA registers, particularly those
  *          controlling the motors should be restored to their previous states
  *          before restarting any motor moves. This is done by setting the
- *          WriteRequest bit for the appropriate registers. The registers currently
- *          reloaded are:
+ *          WriteRequest bit for the appropriate registers. No shadow register is
+ *          considered in sync with the refreshed FPGA, so subsequent writes are
+ *          sent even if unchanged. The registers currently reloaded are:
  *              - FPGA_REG_CONTROL
  *              - FPGA_REG_MOT0_CONTROL
  *              - FPGA_REG_MOT1_CONTROL
@@ -1203,6 +1252,13 @@ bool L3_FpgaIsRefreshPending(void)
  * ========================================================================== */
 void L3_FpgaReload(void)
 {
+    uint8_t Idx;                /* Register Index */
+
+    for (Idx = 0; Idx < FPGA_REG_COUNT; Idx++)
+    {
+        FpgaDynamicMap[Idx].InSync = false;                         // FPGA registers were reset by the refresh
+    }
+
     FpgaDynamicMap[FPGA_REG_CONTROL].WriteRequest = true;           // Request FPGA control reg to be written
 
     FpgaDynamicMap[FPGA_REG_MOT0_CONTROL].WriteRequest = true;      // Request motor control registers to be written
@@ -36,13 +36,13 @@ extern "C"
 /******************************************************************************/
 /*                             Local Define(s) (Macros)                       */
 /******************************************************************************/
-#define CLIP_REFRESH_DURATION          (100u)    /*! Clip refresh duration in mS */
 #define MAX_WIDGET_CLIPS               (3u)      /*! Maximum number of clips that can be played simultaneously */
 #define INVALID_WIDGETINDEX            (0xFFu)   /*! Invalid index */
 #define DISP_WIDTH                     (96u)     /*! Display Width */
 #define DISP_HEIGHT                    (96u)     /*! Display Height */
 #define PALETTE_MAX_TABLE_ENTRIES      (16u)     /*! Maximum entries in palette table */
 #define WIDGET_TEXT_OFFSET             (2u)      /*! Text offset in Pixels from widget start point */       
+#define WIDGET_BITMAP_DRAW_METHOD      (DISP_BITMAP_DRAW_METHOD_RLE16)  /*! Bitmap images carry no format header; all are exported as RLE16 */
 
 /******************************************************************************/
 /*                             Local Type Definition(s)                       */
@@ -50,7 +50,8 @@ extern "C"
 typedef struct                  /*! Extended Clip structure used by Widget server */
 {
     GUI_WIDGET_CLIP *pClip;     /*! Reference to Clip */
-    uint32_t Wait;              /*! Wait time for the current image in the Clip */
+    uint32_t Deadline;          /*! Time (mS) at which the current image in the Clip expires */
+    bool Started;               /*! Current image of the Clip has been drawn */
 } CLIP_ITEM;
 
 /******************************************************************************/
@@ -87,10 +88,80 @@ static const uint32_t ColorPaletteLookup[PALETTE_MAX_TABLE_ENTRIES] =
 /******************************************************************************/
 /*                             Local Function Prototype(s)                    */
 /******************************************************************************/
+static bool WidgetClipPaused(const GUI_WIDGET_CLIP *pClip);
+static uint32_t WidgetClipDraw(GUI_WIDGET_CLIP *pClip);
 
 /******************************************************************************/
 /*                                 Local Functions                            */
 /******************************************************************************/
+/* ========================================================================== */
+/**
+ * \brief   Check if a clip is paused
+ *
+ * \details A clip pauses once it reaches its pause image. A pause image of 0
+ *          lets the clip run continuously.
+ *
+ * \param   pClip - pointer to Clip
+ *
+ * \return  bool - true if the clip is paused
+ *
+ * ========================================================================== */
+static bool WidgetClipPaused(const GUI_WIDGET_CLIP *pClip)
+{
+    return ((pClip->Current >= pClip->Pause) && (pClip->Pause > 0));
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Draw the current image of a clip
+ *
+ * \details The image is looked up directly in the image deck, drawn and
+ *          copied to the display.
+ *
+ * \param   pClip - pointer to Clip
+ *
+ * \return  uint32_t - Image show duration in mS
+ *
+ * ========================================================================== */
+static uint32_t WidgetClipDraw(GUI_WIDGET_CLIP *pClip)
+{
+    GUI_IMAGE_DECK *pImageDeck;
+    Disp_Bitmap DispBmp;
+    DISP_RECT ClipRect;
+    uint32_t Duration;
+
+    Duration = 0;
+
+    do
+    {
+        BREAK_IF(NULL == pClip->ImageDeck);
+
+        pImageDeck = &pClip->ImageDeck[pClip->Current];
+        Duration = pImageDeck->Duration;
+
+        /* Check for a valid image pointer */
+        BREAK_IF(NULL == pImageDeck->pImage);
+
+        /* Populate the Disp_Bitmap structure */
+        DispBmp.pData = (uint8_t*) pImageDeck->pImage;
+        DispBmp.Width = (pClip->Width > DISP_WIDTH) ? DISP_WIDTH : pClip->Width;
+        DispBmp.Height = (pClip->Height > DISP_HEIGHT) ? DISP_HEIGHT : pClip->Height;
+        DispBmp.DrawMethod = WIDGET_BITMAP_DRAW_METHOD;
+
+        L3_DispDrawBitmap(&DispBmp, pClip->X, pClip->Y);
+
+        /* Show the new image, the rest of the display is unchanged */
+        ClipRect.x0 = pClip->X;
+        ClipRect.y0 = pClip->Y;
+        ClipRect.x1 = pClip->X + DispBmp.Width - 1;
+        ClipRect.y1 = pClip->Y + DispBmp.Height - 1;
+        L3_DispMemDevCopyRectToLCD(&ClipRect);
+
+    } while ( false );
+
+    return Duration;
+}
+
 
 /******************************************************************************/
 /*                                 Global Functions                            */
@@ -293,7 +364,7 @@ L3_GUI_WIDGET_STATUS L3_WidgetImageDraw(GUI_WIDGET_IMAGE *pObject)
         DispBmp.Height = (pObject->Height > DISP_HEIGHT) ? DISP_HEIGHT : pObject->Height;
                 
         DispBmp.pData = (uint8_t*)pObject->pBitmap; 
-        DispBmp.DrawMethod = DISP_BITMAP_DRAW_METHOD_RLE16; // Need to confirm
+        DispBmp.DrawMethod = WIDGET_BITMAP_DRAW_METHOD;
          
         L3_DispDrawBitmap(&DispBmp, pObject->X, pObject->Y);        
 
@@ -318,7 +389,7 @@ L3_GUI_WIDGET_STATUS L3_WidgetImageDraw_New(UI_OBJECT_BITMAP *pObject)
         DispBmp.Height = (pObject->Height > DISP_HEIGHT) ? DISP_HEIGHT : pObject->Height;
                 
         DispBmp.pData = (uint8_t*)pObject->pBitmap; 
-        DispBmp.DrawMethod = DISP_BITMAP_DRAW_METHOD_RLE16; // Need to confirm
+        DispBmp.DrawMethod = WIDGET_BITMAP_DRAW_METHOD;
          
         L3_DispDrawBitmap(&DispBmp, pObject->X, pObject->Y);        
 
@@ -329,19 +400,119 @@ L3_GUI_WIDGET_STATUS L3_WidgetImageDraw_New(UI_OBJECT_BITMAP *pObject)
 }
 //#############################################################################################################
 /* ========================================================================== */
+/**
+ * \brief   Function to get the area drawn by a UI object
+ *
+ * \details This function gets the rectangle the object's draw function paints,
+ *          clipped to the display. The rectangle is empty (x1 < x0) if the
+ *          object draws nothing.
+ *
+ * \param   pObject - pointer to UI object
+ * \param   pRect - pointer to return the rectangle (inclusive coordinates)
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_WidgetObjectRect(UI_OBJECT *pObject, DISP_RECT *pRect)
+{
+    DISP_RECT BoxRect;      /* Text background box */
+
+    do
+    {
+        if ( NULL == pRect )
+        {
+            break;
+        }
+
+        /* Empty unless the object draws something */
+        pRect->x0 = 0;
+        pRect->y0 = 0;
+        pRect->x1 = -1;
+        pRect->y1 = -1;
+
+        if ( NULL == pObject )
+        {
+            break;
+        }
+
+        switch ( pObject->OurObjectType )
+        {
+            case UI_TYPE_TEXT:
+                L3_DispGetStringRect((FONT_TYPE)pObject->ObjText.FontType, pObject->ObjText.X + WIDGET_TEXT_OFFSET,
+                                     pObject->ObjText.Y, (int8_t*)pObject->ObjText.Text, pRect);
+
+                if ( SIG_COLOR_TRANSPARENT != pObject->ObjText.BackColor )
+                {
+                    BoxRect.x0 = pObject->ObjText.X;
+                    BoxRect.y0 = pObject->ObjText.Y;
+                    BoxRect.x1 = pObject->ObjText.X + pObject->ObjText.Width;
+                    BoxRect.y1 = pObject->ObjText.Y + pObject->ObjText.Height;
+
+                    pRect->x0 = (BoxRect.x0 < pRect->x0) ? BoxRect.x0 : pRect->x0;
+                    pRect->y0 = (BoxRect.y0 < pRect->y0) ? BoxRect.y0 : pRect->y0;
+                    pRect->x1 = (BoxRect.x1 > pRect->x1) ? BoxRect.x1 : pRect->x1;
+                    pRect->y1 = (BoxRect.y1 > pRect->y1) ? BoxRect.y1 : pRect->y1;
+                }
+                break;
+
+            case UI_TYPE_CIRCLE:
+                pRect->x0 = pObject->ObjCircle.X - pObject->ObjCircle.Radius;
+                pRect->y0 = pObject->ObjCircle.Y - pObject->ObjCircle.Radius;
+                pRect->x1 = pObject->ObjCircle.X + pObject->ObjCircle.Radius;
+                pRect->y1 = pObject->ObjCircle.Y + pObject->ObjCircle.Radius;
+                break;
+
+            case UI_TYPE_BITMAP:
+                pRect->x0 = pObject->ObjBitmap.X;
+                pRect->y0 = pObject->ObjBitmap.Y;
+                pRect->x1 = pObject->ObjBitmap.X + ((pObject->ObjBitmap.Width > DISP_WIDTH) ? DISP_WIDTH : pObject->ObjBitmap.Width) - 1;
+                pRect->y1 = pObject->ObjBitmap.Y + ((pObject->ObjBitmap.Height > DISP_HEIGHT) ? DISP_HEIGHT : pObject->ObjBitmap.Height) - 1;
+                break;
+
+            case UI_TYPE_PROGRESS:
+                /* Not drawn with an invalid range */
+                if ( pObject->ObjProgress.Max > pObject->ObjProgress.Min )
+                {
+                    pRect->x0 = pObject->ObjProgress.X;
+                    pRect->y0 = pObject->ObjProgress.Y;
+                    pRect->x1 = pObject->ObjProgress.X + pObject->ObjProgress.Width;
+                    pRect->y1 = pObject->ObjProgress.Y + pObject->ObjProgress.Height;
+                }
+                break;
+
+            default:
+                /* Square is not drawn */
+                break;
+        }
+
+        /* Clip to the display */
+        pRect->x0 = (pRect->x0 < 0) ? 0 : pRect->x0;
+        pRect->y0 = (pRect->y0 < 0) ? 0 : pRect->y0;
+        pRect->x1 = (pRect->x1 >= (int16_t)DISP_WIDTH) ? ((int16_t)DISP_WIDTH - 1) : pRect->x1;
+        pRect->y1 = (pRect->y1 >= (int16_t)DISP_HEIGHT) ? ((int16_t)DISP_HEIGHT - 1) : pRect->y1;
+
+    } while ( false );
+}
+//#############################################################################################################
+/* ========================================================================== */
 /**
  * \fn      L3_GUI_WIDGET_STATUS L3_WidgetServerRun (void)   
  *
- * \brief   Function to update dynamic objects periodically. Should be called from 
- *          display manager task context at a periodicity set by GUI_WIDGET_UPDATE_PERIOD.
+ * \brief   Function to update dynamic objects. Should be called from display
+ *          manager task context when the wait from L3_WidgetServerNextWait
+ *          has elapsed.
  *
  * \details This function uses L3 Display Port module API's to display all the
- *          clips. A Clip is displayed only if it hasn't reached the end or if
- *          it hasn't reached the pause frame 
+ *          clips. A Clip moves to its next image only when the show duration of
+ *          the current image has expired, and not once it reaches the pause frame.
+ *          Image deadlines advance by the image duration, so a late run does
+ *          not delay the rest of the clip.
  *            
  * \param   < None >
  *  
  * \return  L3_GUI_WIDGET_STATUS
+ * \retval  L3_GUI_WIDGET_STATUS_ERROR - No clip updated
+ * \retval  L3_GUI_WIDGET_STATUS_OK - At least one clip updated
  *
  * ========================================================================== */
 L3_GUI_WIDGET_STATUS L3_WidgetServerRun (void)
@@ -349,71 +520,61 @@ L3_GUI_WIDGET_STATUS L3_WidgetServerRun (void)
     L3_GUI_WIDGET_STATUS WidgetStatus;
     WidgetStatus = L3_GUI_WIDGET_STATUS_ERROR;
 
-    Disp_Bitmap DispBmp;
-    
-    static CLIP_ITEM *Item;
-    GUI_IMAGE_DECK *pImageDeck;
-    uint8_t Index;
+    CLIP_ITEM *Item;
+    GUI_WIDGET_CLIP *pClip;
+    uint32_t Now;
+    uint32_t Duration;
     
+    Now = SigTime();
+
     /* Loop through all the clips */
     for ( uint8_t i = 0; i < MAX_WIDGET_CLIPS; i++)
     {                        
         Item = &ClipList[i];
+        pClip = Item->pClip;
         do
         { 
-            if (NULL == Item->pClip)
+            if (NULL == pClip)
             {
                 break;
             }
 
-            /* if the clip paused, no need to update the image, just return */
-            if ((Item->pClip->Current >= Item->pClip->Pause) && (Item->pClip->Pause >0))
+            /* Check if the current image has expired (wrap safe) */
+            if ((int32_t)(Now - Item->Deadline) < 0)
             {
                 break;
             }
 
-            /* Update running timer */
-            Item->Wait = (Item->Wait > CLIP_REFRESH_DURATION)? (Item->Wait-CLIP_REFRESH_DURATION) : 0 ;
-            
-            /* Check if the running timer reached down to zero */
-            if (Item->Wait > 0)
-            {
-                break;    
-            }        
-
-            /* Time to refresh the clip with next image */
-
-            Item->pClip->Current++;
-            if (Item->pClip->Current >= Item->pClip->ImageCount)
+            if (Item->Started)
             {
-                Item->pClip->Current = 0;       /* Rollover */                
+                /* if the clip paused, no need to update the image */
+                if (WidgetClipPaused(pClip))
+                {
+                    break;
+                }
+
+                /* Time to refresh the clip with next image */
+                pClip->Current++;
+                if (pClip->Current >= pClip->ImageCount)
+                {
+                    pClip->Current = 0;       /* Rollover */                
+                }
             }
-
-            /* Extract Image deck and find the image as per the 'Current' index */
-            pImageDeck = Item->pClip->ImageDeck;
-            for(Index=0; Index < Item->pClip->Current ; Index++) 
+            else
             {
-                pImageDeck++;
+                /* First image is shown as soon as the clip starts */
+                Item->Started = true;
+                Item->Deadline = Now;
             }
 
-            /* Check for a valid image pointer */
-            if( NULL == pImageDeck)
+            Duration = WidgetClipDraw(pClip);
+
+            /* Next deadline follows on from this one; resync if more than an image behind */
+            Item->Deadline += Duration;
+            if ((int32_t)(Now - Item->Deadline) >= 0)
             {
-                break;
+                Item->Deadline = Now + Duration;
             }
-
-            /* Got image to display, also extract the duration to display the image */
-
-            DispBmp.pData = (uint8_t*) pImageDeck->pImage;
-            Item->Wait = pImageDeck->Duration;            
-            
-            /* Populate the Disp_Bitmap structure */
-            DispBmp.Width = (Item->pClip->Width > DISP_WIDTH) ? DISP_WIDTH : Item->pClip->Width;
-            DispBmp.Height = (Item->pClip->Height > DISP_HEIGHT) ? DISP_HEIGHT : Item->pClip->Height;
-
-            DispBmp.DrawMethod = DISP_BITMAP_DRAW_METHOD_RLE16; /* \todo: pick it from the BMP structure */
-
-            L3_DispDrawBitmap(&DispBmp, Item->pClip->X, Item->pClip->Y);           
             
             WidgetStatus = L3_GUI_WIDGET_STATUS_OK;
              
@@ -423,6 +584,49 @@ L3_GUI_WIDGET_STATUS L3_WidgetServerRun (void)
     return WidgetStatus;
 }
 
+/* ========================================================================== */
+/**
+ * \fn      uint32_t L3_WidgetServerNextWait(void)
+ *
+ * \brief   Function to get the time until the widget server has work to do
+ *
+ * \details Returns the time to the earliest image change across all the
+ *          playing clips, so that the caller can sleep until then. Paused
+ *          clips have no image change due.
+ *            
+ * \param   < None >
+ *  
+ * \return  uint32_t - Time to the next L3_WidgetServerRun in mS, 0 if it is
+ *                     due now, GUI_WIDGET_SERVER_IDLE if no clip is playing.
+ *
+ * ========================================================================== */
+uint32_t L3_WidgetServerNextWait(void)
+{
+    CLIP_ITEM *Item;
+    GUI_WIDGET_CLIP *pClip;
+    uint32_t Now;
+    uint32_t Wait;
+    int32_t Remaining;
+
+    Wait = GUI_WIDGET_SERVER_IDLE;
+    Now = SigTime();
+
+    for ( uint8_t i = 0; i < MAX_WIDGET_CLIPS; i++)
+    {
+        Item = &ClipList[i];
+        pClip = Item->pClip;
+
+        if ((NULL != pClip) && !(Item->Started && WidgetClipPaused(pClip)))
+        {
+            Remaining = (int32_t)(Item->Deadline - Now);
+            Remaining = (Remaining > 0) ? Remaining : 0;
+            Wait = ((uint32_t)Remaining < Wait) ? (uint32_t)Remaining : Wait;
+        }
+    }
+
+    return Wait;
+}
+
 /**
  * \}  <If using addtogroup above>
  */
@@ -23,6 +23,7 @@ extern "C"
 /*                             Include(s)                                     */
 /******************************************************************************/
 #include "Common.h"         /* Import common definitions such as types, etc. */
+#include "L3_DispPort.h"    /* DISP_RECT */
 
 /******************************************************************************/
 /*                             Global Define(s) (Macros)                      */
@@ -30,6 +31,7 @@ extern "C"
 #define MAX_TEXT_SIZE               (20u)   /*! Maximum supported text size */
 #define MAX_CLIP_IMAGES             (11u)   /*! Maximum number of images supported in a Clip widget */
 #define GUI_WIDGET_UPDATE_PERIOD    (1u)    /*! Period at which the widgets are refreshed */
+#define GUI_WIDGET_SERVER_IDLE      (0xFFFFFFFFu)  /*! Widget server wait when no clip is playing */
 #define WIDGET_SERVER_RUN_TIME      (50u)   /*! 50 msec */
 
 /******************************************************************************/
@@ -259,11 +261,13 @@ extern L3_GUI_WIDGET_STATUS L3_WidgetImageDraw(GUI_WIDGET_IMAGE *pObject);
 
 void L3_WidgetPaintWindow(SIG_COLOR_PALETTE Color, uint8_t X, uint8_t Y, uint8_t Width, uint8_t Height);
 extern L3_GUI_WIDGET_STATUS L3_WidgetServerRun (void);
+extern uint32_t L3_WidgetServerNextWait(void);
 
 L3_GUI_WIDGET_STATUS L3_WidgetTextDraw_New(UI_OBJECT_TEXT *pObject);
 L3_GUI_WIDGET_STATUS L3_WidgetImageDraw_New(UI_OBJECT_BITMAP *pObject);
 L3_GUI_WIDGET_STATUS L3_WidgetProgressBarDraw_New(UI_OBJECT_PROGRESS *pObject);
 L3_GUI_WIDGET_STATUS L3_WidgetCircleDraw(UI_OBJECT_CIRCLE *pObject);
+void L3_WidgetObjectRect(UI_OBJECT *pObject, DISP_RECT *pRect);
 /**
  * \}  <If using addtogroup above>
  */
@@ -67,6 +67,7 @@ const char *StopStr[MOT_NUM_RDF_STOPINFO_MSGS] =
 #define MOTOR_REG_SYNC_PERIOD   (FPGA_SYNC_PERIOD + 2u) ///< Initial motor register sync wait
 #define ALLEGRO_STABILIZE_TIME  (50u)                   ///< Time to allow allegro chips to stabilize after enabling.
 #define MOTOR_CUR_PWM_MAX       (0x1FFu)                ///< Full scale for motor current limit PWM
+#define MOTOR_PERIOD_TO_RPM     ((uint32_t)(SEC_PER_MIN / FPGA_PERIOD_TIME))   ///< RPM x FPGA period counts per revolution (folded at compile time)
 
 #define MOTOR_BLOCK_BASE        (4u)                    ///< Motor register bank base
 #define MOTOR_REG(Motor, Reg)   ((FPGA_REG)(MOTOR_BLOCK_BASE + ((uint8_t)(Motor) * MOTOR_REG_COUNT) + (uint8_t)(Reg))) ///< Motor register by motor ID
@@ -539,7 +540,11 @@ static void MotorPublishStopSig(MOTOR_CTRL_PARAM *pMotor)
 static void MotorUpdateSpeed(MOTOR_CTRL_PARAM *pMotor)
 {
     uint32_t    MotorPeriod;    // Period from FPGA
+#ifdef MOT_FIXED_POINT_SPEED
+    uint32_t    TempSpeed;      // Calculated speed from period
+#else
     float32_t   TempSpeed;      // Calculated speed from period
+#endif
 
     if (labs(pMotor->TicksThisMs) > MAX_TICKS_PER_MS)
     {
@@ -563,8 +568,14 @@ static void MotorUpdateSpeed(MOTOR_CTRL_PARAM *pMotor)
         // Denominator is time / revolution in seconds based on latest period.
         // Reciprocal is taken to get revolutions / sec.
         // Multiply by 60 to get RPM.
-
+#ifdef MOT_FIXED_POINT_SPEED
+        // Same calculation, rearranged as (60 / FPGA_PERIOD_TIME) / MotorPeriod. The numerator
+        // is a compile time constant, so this is one integer divide rather than double precision
+        // math (The Cortex-M4 FPU is single precision only). Result is truncated, as before.
+        TempSpeed = MOTOR_PERIOD_TO_RPM / MotorPeriod;
+#else
         TempSpeed = (1.0 / ((float32_t)MotorPeriod * FPGA_PERIOD_TIME)) * (float32_t)SEC_PER_MIN;
+#endif
     }
     pMotor->MotorInstSpeed = (uint32_t)TempSpeed;
 
@@ -605,7 +616,7 @@ static void MotorUpdatePwm(MOTOR_CTRL_PARAM *pMotor)
     {
         // Calculate %error
         Error = ((float32_t)pMotor->TargetSpeed - (float32_t)pMotor->VelocityFilter.Rpm) / (float32_t)pMotor->TargetSpeed;
-        if (fabs((float32_t)pMotor->TargetSpeed - (float32_t)pMotor->VelocityFilter.Rpm) < pMotor->RpmThresh)
+        if (fabsf((float32_t)pMotor->TargetSpeed - pMotor->VelocityFilter.Rpm) < (float32_t)pMotor->RpmThresh)     // Single precision - fabs promotes to double
         {
             Error = 0;      // Error too small to worry about. Force to 0.
         }
@@ -37,6 +37,11 @@ extern "C"
 #define MOT_POSITION_TOLERANCE         (5u)                                         ///< Ticks from Target Position to initate motor stop
 #define MOT_RPM_PER_TICK_PER_MSEC      (MSEC_PER_MIN / HANDLE_PARAM_TICKS_PER_REV)  ///< Tick/msec to RPM Factor: (mSec * Revs)/(minute * ticks)
 
+/* With MOT_FIXED_POINT_SPEED defined, the instantaneous speed is computed from the
+   FPGA period with a single integer divide. Undefine to use the floating point
+   reference calculation. */
+#define MOT_FIXED_POINT_SPEED
+
 // Stop status bit values:
 
 /// \todo 08/05/2021 DAZ - This list needs some cleanup. (ie. SPM_ES is unused, NO_STAPLES may not be used) Implement as bitmap ENUM?
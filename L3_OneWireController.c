@@ -157,6 +157,8 @@ uint8_t challengeData[ONEWIRE_MEMORY_BANK_SIZE + MEMORY_FENCE_SIZE_BYTES];
 uint8_t masterMAC[ONEWIRE_MEMORY_BANK_SIZE + MEMORY_FENCE_SIZE_BYTES];            ///< Memory bank to store 1-wire Master MAC data
 
 static uint8_t BusShortCounter[ONEWIRE_BUS_COUNT];
+static ONEWIRE_STATS OwStats;                           ///< Controller timing statistics
+static ONEWIRE_EVENT_HNDLR OwDeviceListener = NULL;     ///< Registry listener, told of devices added and removed
 static bool BusShorted[ONEWIRE_BUS_COUNT] = {false};
 
 /******************************************************************************/
@@ -203,6 +205,7 @@ static bool OWTransferHandlerSlaveMac(uint8_t PacketIndex, uint8_t* pRxData);
 static void OwFrameClear(ONEWIREFRAME* pFrame );
 static ONEWIRE_STATUS L3_CheckConnectorBus(void);
 static ONEWIRE_STATUS L3_CheckClamshellBus(void);
+static void OwStatsUpdate(ONEWIRE_OP_STATS *pOpStats, uint32_t StartCycles, bool Failed);
 /******************************************************************************/
 /*                             Local Function(s)                              */
 /******************************************************************************/
@@ -500,6 +503,10 @@ static void OwCheckDevices(void)
                     if (ONEWIRE_STATUS_NO_DEVICE == Status)
                     {
                         OwNotifyBusUser(ONEWIRE_EVENT_LOST_DEVICE, pDevInfo->Bus, pDevInfo->Device);
+                        if (NULL != OwDeviceListener)
+                        {
+                            OwDeviceListener(ONEWIRE_EVENT_LOST_DEVICE, pDevInfo->Device);
+                        }
 
                         /* Remove device from the list */
                         pDevInfo->Device = ONEWIRE_DEVICE_ID_INVALID;
@@ -578,6 +585,10 @@ static ONEWIRE_STATUS OwDeviceRegistryAdd(ONEWIRE_DEVICE_ID Device, ONEWIRE_BUS
         }
 
         /* We found an empty slot and no duplicates, add it to the registry */
+        if (NULL != OwDeviceListener)
+        {
+            OwDeviceListener(ONEWIRE_EVENT_NEW_DEVICE, Device);
+        }
         OwDeviceList[Empty].Device = Device;
         OwDeviceList[Empty].Bus = Bus;
         OwDeviceList[Empty].Family = (ONEWIRE_DEVICE_FAMILY)(Device & (ONEWIRE_DEVICE_ID)0xFF);  /* Lower byte has family code */
@@ -744,6 +755,7 @@ static void OwProcessScan(void)
     uint8_t Index;
     ONEWIRE_BUS BusToScan;          /* Bus to be scanned */
     ONEWIREOPTIONS *pBusOptions;
+    uint32_t StartCycles;           /* Cycle count at the start of the scan */
     BusToScan = ONEWIRE_BUS_CLAMSHELL;
 
     do
@@ -789,7 +801,10 @@ static void OwProcessScan(void)
             NewDeviceCount = (pBusOptions->DeviceCount <= ONEWIRE_MAX_DEVICES) ? pBusOptions->DeviceCount: ONEWIRE_MAX_DEVICES;
 
             /* Start the scan */
+            StartCycles = CPU_COUNTER_READ_CYCLES();
             Status = OwTransportScan(BusToScan, OW_SCAN_TYPE_FULL, NewOwDeviceList, &NewDeviceCount);
+            OwStatsUpdate(&OwStats.Scan[BusToScan], StartCycles, (ONEWIRE_STATUS_OK != Status) && (ONEWIRE_STATUS_NO_DEVICE != Status));
+            OwStats.Found[BusToScan] = (ONEWIRE_STATUS_OK == Status) ? NewDeviceCount : 0;
 
             /* Scan complete, did we find more devices? Or encountered errors? */
             switch(Status)
@@ -863,8 +878,10 @@ static ONEWIRE_STATUS OwProcessTransferRequest(ONEWIREFRAME *pFrame)
     ONEWIRE_STATUS Status;
     uint8_t Index;
     ONEWIRE_DEVICE_ID *pAddr;
+    uint32_t StartCycles;           /* Cycle count at the start of the transfer */
 
     Status = ONEWIRE_STATUS_ERROR;  /* Default status */
+    StartCycles = CPU_COUNTER_READ_CYCLES();
 
     /* pFrame is already validated by the caller, it's safe to access */
     pAddr = &pFrame->Device; /* Needed to control device select command which is sent only once */
@@ -927,6 +944,8 @@ static ONEWIRE_STATUS OwProcessTransferRequest(ONEWIREFRAME *pFrame)
     /* terminate the transfer */
     OwTransportReceive(NULL, 0);
 
+    OwStatsUpdate(&OwStats.Transfer, StartCycles, (ONEWIRE_STATUS_OK != Status));
+
     return Status;
 }
 
@@ -1315,7 +1334,9 @@ static ONEWIRE_STATUS OwProcessDeviceCheckRequest( ONEWIRE_DEVICE_ID Device)
 static ONEWIRE_STATUS OwProcessDeviceAuthenticateRequest(ONEWIRE_DEVICE_ID Device)
 {
     ONEWIRE_STATUS Status;
+    uint32_t StartCycles;       /* Cycle count at the start of the authentication */
 
+    StartCycles = CPU_COUNTER_READ_CYCLES();
     Status = OwSelectBusByDevice(Device);
 
 
@@ -1326,6 +1347,8 @@ static ONEWIRE_STATUS OwProcessDeviceAuthenticateRequest(ONEWIRE_DEVICE_ID Devic
         Status = OneWireVerifySecret(Device);
     }
 
+    OwStatsUpdate(&OwStats.Authenticate, StartCycles, (ONEWIRE_STATUS_OK != Status));
+
     return Status;
 }
 
@@ -2593,6 +2616,8 @@ ONEWIRE_STATUS L3_OneWireInit(void)
         /* Activate disabled state */
         L3_OneWireEnable(false);
 
+        L3_OneWireStatsReset();
+
         /* Default initialization for each bus */
         for (Index=0; Index < ONEWIRE_BUS_COUNT; Index++)
         {
@@ -2897,6 +2922,112 @@ ONEWIRE_STATUS L3_OneWireAuthenticate(ONEWIRE_DEVICE_ID Device)
     return Status;
 }
 
+/* ========================================================================== */
+/**
+ * \fn      void L3_OneWireDeviceListenerSet(ONEWIRE_EVENT_HNDLR pHandler)
+ *
+ * \brief   Set the 1-Wire device registry listener
+ *
+ * \details The listener is called from the 1-Wire task with
+ *          ONEWIRE_EVENT_NEW_DEVICE when a device is added to the registry and
+ *          ONEWIRE_EVENT_LOST_DEVICE when it is removed, whatever the bus
+ *          options. Lets a device layer drop state kept about a device.
+ *
+ * \param   pHandler - listener to call, NULL for none
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_OneWireDeviceListenerSet(ONEWIRE_EVENT_HNDLR pHandler)
+{
+    OwDeviceListener = pHandler;
+}
+
+/* ========================================================================== */
+/**
+ * \fn      void L3_OneWireStatsGetAndReset(ONEWIRE_STATS *pStats)
+ *
+ * \brief   Get and restart the 1-Wire controller statistics
+ *
+ * \details Gets the bus scan, authentication and transfer timing gathered
+ *          since the last reset, and restarts it. Both are done in one
+ *          critical section, so no operation finishing meanwhile is lost.
+ *          Together with the failure simulation in the test manager, this
+ *          allows benchmarking the scan period, enumeration time and
+ *          authentication latency on a bus. Reported by the
+ *          SERIALCMD_ONEWIRE_GET_STATUS console command.
+ *
+ * \param   pStats - pointer to return the statistics
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_OneWireStatsGetAndReset(ONEWIRE_STATS *pStats)
+{
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    if (NULL != pStats)
+    {
+        OS_ENTER_CRITICAL();
+        *pStats = OwStats;
+        memset(&OwStats, 0, sizeof(OwStats));
+        OwStats.StartTime = SigTime();
+        OS_EXIT_CRITICAL();
+    }
+}
+
+/* ========================================================================== */
+/**
+ * \fn      void L3_OneWireStatsReset(void)
+ *
+ * \brief   Restart the 1-Wire controller statistics
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L3_OneWireStatsReset(void)
+{
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    OS_ENTER_CRITICAL();
+    memset(&OwStats, 0, sizeof(OwStats));
+    OwStats.StartTime = SigTime();
+    OS_EXIT_CRITICAL();
+}
+
+/* ========================================================================== */
+/**
+ * \fn      void OwStatsUpdate(ONEWIRE_OP_STATS *pOpStats, uint32_t StartCycles, bool Failed)
+ *
+ * \brief   Add an operation to the statistics
+ *
+ * \param   pOpStats - Statistics of the operation kind
+ * \param   StartCycles - CPU cycle count when the operation started
+ * \param   Failed - true if the operation failed
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void OwStatsUpdate(ONEWIRE_OP_STATS *pOpStats, uint32_t StartCycles, bool Failed)
+{
+    uint32_t OpTime;            /* Operation time (uS) */
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    OpTime = CPU_CYCLES_TO_USEC(CPU_COUNTER_READ_CYCLES() - StartCycles);
+
+    OS_ENTER_CRITICAL();
+    pOpStats->Count++;
+    pOpStats->Errors += Failed ? 1u : 0u;
+    pOpStats->TimeTotal += OpTime;
+    if (OpTime > pOpStats->TimeMax)
+    {
+        pOpStats->TimeMax = OpTime;
+    }
+    OS_EXIT_CRITICAL();
+}
+
 /* ========================================================================== */
 /**
  * \fn      ONEWIRE_STATUS L3_CheckConnectorBus(void)
@@ -97,6 +97,29 @@ typedef struct
     ONEWIRE_DEVICE_FAMILY   Family;             ///< Device family, duplicate from device address to simplify sorting
 } OWDEVICEINFO;
 
+/*! \struct ONEWIRE_OP_STATS
+ *  Timing of one kind of 1-Wire operation.
+ */
+typedef struct
+{
+    uint32_t                Count;              ///< Operations performed
+    uint32_t                Errors;             ///< Operations failed
+    uint64_t                TimeTotal;          ///< Total time of the operations (uS). 64 bits: 32 would wrap after ~71 minutes
+    uint32_t                TimeMax;            ///< Longest operation (uS)
+} ONEWIRE_OP_STATS;
+
+/*! \struct ONEWIRE_STATS
+ *  1-Wire controller timing, since the statistics were last reset.
+ */
+typedef struct
+{
+    uint32_t                StartTime;                  ///< Time the statistics were reset (mS)
+    ONEWIRE_OP_STATS        Scan[ONEWIRE_BUS_COUNT];    ///< Bus scans, by bus. Count over elapsed time gives the scan period
+    uint8_t                 Found[ONEWIRE_BUS_COUNT];   ///< Devices found by the last scan, by bus
+    ONEWIRE_OP_STATS        Authenticate;               ///< Device authentications
+    ONEWIRE_OP_STATS        Transfer;                   ///< Frame transfers
+} ONEWIRE_STATS;
+
 /******************************************************************************/
 /*                             Global Function Prototype(s)                   */
 /******************************************************************************/
@@ -108,6 +131,9 @@ extern ONEWIRE_STATUS L3_OneWireDeviceGetByBus(ONEWIRE_BUS Bus, ONEWIRE_DEVICE_I
 extern ONEWIRE_STATUS L3_OneWireDeviceCheck(ONEWIRE_DEVICE_ID Device);
 extern ONEWIRE_STATUS L3_OneWireTransfer(ONEWIREFRAME *pFrame);  
 extern ONEWIRE_STATUS L3_OneWireAuthenticate(ONEWIRE_DEVICE_ID Device);
+extern void L3_OneWireDeviceListenerSet(ONEWIRE_EVENT_HNDLR pHandler);
+extern void L3_OneWireStatsGetAndReset(ONEWIRE_STATS *pStats);
+extern void L3_OneWireStatsReset(void);
 /**
  * \}  <If using addtogroup above>
  */
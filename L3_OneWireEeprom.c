@@ -59,6 +59,8 @@ extern "C" {
                                                                    /* Refer to https://www.maximintegrated.com/en/design/technical-documents/app-notes/2/27.html. */
 #define OW_EEPROM_TXFER_WAIT                       (12u)           ///< Delay value used to wait after sending the Release command.
 #define OW_EEPROM_NUM_PKTS_PER_SEGMENT             (3u)            ///< This value is used for converting the PacketIndex to Packet type while doing the write operation.
+#define OW_EEPROM_IMAGE_COUNT                      (ONEWIRE_MAX_DEVICES)  ///< One memory image per registered device.
+#define OW_EEPROM_IMAGE_SIZE                       (OW_EEPROM_NUM_PAGES * OW_EEPROM_MEMORY_PAGE_SIZE)  ///< Memory image size in bytes.
 /******************************************************************************/
 /*                             Local Type Definition(s)                       */
 /******************************************************************************/
@@ -69,6 +71,13 @@ typedef enum                        /// 1-Wire EEPROM Pkt Type used for write op
     OW_EEPROM_PKT_DEFAULT = 3       ///< Default Packet Type.
 } OW_EEPROM_PKT_TYPE;
 
+typedef struct                      /// RAM image of a 1-Wire EEPROM device memory.
+{
+    ONEWIRE_DEVICE_ID Device;       ///< Device the image belongs to.
+    uint8_t ValidPages;             ///< Bit mask of the pages holding the device data, 0 if the image is unused.
+    uint8_t Data[OW_EEPROM_IMAGE_SIZE];  ///< Memory image.
+} OW_EEPROM_IMAGE;
+
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
 /******************************************************************************/
@@ -76,10 +85,22 @@ typedef enum                        /// 1-Wire EEPROM Pkt Type used for write op
 /******************************************************************************/
 /*                             Local Variable Definition(s)                   */
 /******************************************************************************/
+#ifdef OW_EEPROM_CACHE
+static OW_EEPROM_IMAGE OwEepromImage[OW_EEPROM_IMAGE_COUNT];    ///< Memory images of the devices read or written.
+static uint32_t OwEepromImageGen;                               ///< Changed on every write or invalidation of an image
+#endif
 
 /******************************************************************************/
 /*                             Local Function Prototype(s)                    */
 /******************************************************************************/
+#ifdef OW_EEPROM_CACHE
+static OW_EEPROM_IMAGE *OwEepromImageFind(ONEWIRE_DEVICE_ID Device, bool Create);
+static bool OwEepromImageRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pBuffer);
+static void OwEepromImageUpdate(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pData, bool Valid);
+static uint32_t OwEepromImageGenGet(void);
+static void OwEepromImageFill(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pData, uint32_t Generation);
+static void OwEepromDeviceEvent(ONEWIRE_EVENT Event, ONEWIRE_DEVICE_ID Device);
+#endif
 
 /******************************************************************************/
 /*                             Local Function(s)                              */
@@ -153,6 +174,7 @@ static bool OwTransferHandler_Rx(uint8_t PacketIndex, uint8_t *RxData)
         case 0:
             break;
 
+        /* Wait once after the first page; following pages stream without a wait */
         case 1:
             OSTimeDly(OW_EEPROM_TXFER_WAIT);
             break;
@@ -276,6 +298,215 @@ static OW_EEP_STATUS OwFrameTransfer(ONEWIREFRAME *pFrame)
 
 }
 
+#ifdef OW_EEPROM_CACHE
+/* ========================================================================== */
+/**
+ * \brief   Find the memory image of a device
+ *
+ * \note    To be called with interrupts disabled.
+ *
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ * \param   Create - Take an unused image if the device has none.
+ *
+ * \return  OW_EEPROM_IMAGE - Image of the device, NULL if none (or none free).
+ *
+ * ========================================================================== */
+static OW_EEPROM_IMAGE *OwEepromImageFind(ONEWIRE_DEVICE_ID Device, bool Create)
+{
+    OW_EEPROM_IMAGE *pImage;    /* Image of the device */
+    OW_EEPROM_IMAGE *pFree;     /* First unused image */
+    uint8_t Index;
+
+    pImage = NULL;
+    pFree = NULL;
+
+    for (Index = 0; Index < OW_EEPROM_IMAGE_COUNT; Index++)
+    {
+        if (0 == OwEepromImage[Index].ValidPages)
+        {
+            pFree = (NULL == pFree) ? &OwEepromImage[Index] : pFree;
+        }
+        else if (Device == OwEepromImage[Index].Device)
+        {
+            pImage = &OwEepromImage[Index];
+            break;
+        }
+        else
+        {
+            /* Image of another device */
+        }
+    }
+
+    if ((NULL == pImage) && Create && (NULL != pFree))
+    {
+        pImage = pFree;
+        pImage->Device = Device;
+        L3_OneWireDeviceListenerSet(&OwEepromDeviceEvent);  /* Drop the image when the device leaves */
+    }
+
+    return pImage;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Read pages from the memory image of a device
+ *
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ * \param   Page - First EEPROM page number.
+ * \param   PageCount - Number of pages to read.
+ * \param   pBuffer - Buffer to store data.
+ *
+ * \return  bool - true if all the pages were read from the image
+ *
+ * ========================================================================== */
+static bool OwEepromImageRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pBuffer)
+{
+    OW_EEPROM_IMAGE *pImage;
+    uint8_t PageMask;           /* Pages to read */
+    bool Found;
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    Found = false;
+    PageMask = (uint8_t)(((1u << PageCount) - 1u) << Page);
+
+    OS_ENTER_CRITICAL();
+    pImage = OwEepromImageFind(Device, false);
+    if ((NULL != pImage) && (PageMask == (pImage->ValidPages & PageMask)))
+    {
+        memcpy(pBuffer, &pImage->Data[Page * OW_EEPROM_MEMORY_PAGE_SIZE], PageCount * OW_EEPROM_MEMORY_PAGE_SIZE);
+        Found = true;
+    }
+    OS_EXIT_CRITICAL();
+
+    return Found;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Update pages in the memory image of a device
+ *
+ * \details Pages written to the device are stored in its image. Pages whose
+ *          content is unknown, such as after a failed write, are marked
+ *          invalid to be read from the device again. Either way, reads from
+ *          the bus that were in progress no longer fill the image.
+ *
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ * \param   Page - First EEPROM page number.
+ * \param   PageCount - Number of pages.
+ * \param   pData - Device data of the pages, not used if Valid is false.
+ * \param   Valid - true to store the pages, false to mark them invalid.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void OwEepromImageUpdate(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pData, bool Valid)
+{
+    OW_EEPROM_IMAGE *pImage;
+    uint8_t PageMask;           /* Pages to update */
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    PageMask = (uint8_t)(((1u << PageCount) - 1u) << Page);
+
+    OS_ENTER_CRITICAL();
+    OwEepromImageGen++;
+    pImage = OwEepromImageFind(Device, Valid);
+    if (NULL != pImage)
+    {
+        if (Valid)
+        {
+            memcpy(&pImage->Data[Page * OW_EEPROM_MEMORY_PAGE_SIZE], pData, PageCount * OW_EEPROM_MEMORY_PAGE_SIZE);
+            pImage->ValidPages |= PageMask;
+        }
+        else
+        {
+            pImage->ValidPages &= (uint8_t)~PageMask;
+        }
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Get the memory image generation
+ *
+ * \details To be read before a read from the bus, and passed to
+ *          OwEepromImageFill with the data read.
+ *
+ * \param   < None >
+ *
+ * \return  uint32_t - Image generation
+ *
+ * ========================================================================== */
+static uint32_t OwEepromImageGenGet(void)
+{
+    uint32_t Generation;
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    OS_ENTER_CRITICAL();
+    Generation = OwEepromImageGen;
+    OS_EXIT_CRITICAL();
+
+    return Generation;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Fill the memory image of a device with pages read from the bus
+ *
+ * \details The pages are stored only if no image was written or invalidated
+ *          since the read started, so a read that overlapped a write cannot
+ *          put back the data the write replaced.
+ *
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ * \param   Page - First EEPROM page number.
+ * \param   PageCount - Number of pages.
+ * \param   pData - Pages read from the device.
+ * \param   Generation - Image generation read before the read started.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void OwEepromImageFill(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pData, uint32_t Generation)
+{
+    OW_EEPROM_IMAGE *pImage;
+    OS_CPU_SR cpu_sr;           // CPU status register for critical section macro
+
+    OS_ENTER_CRITICAL();
+    if (Generation == OwEepromImageGen)
+    {
+        pImage = OwEepromImageFind(Device, true);
+        if (NULL != pImage)
+        {
+            memcpy(&pImage->Data[Page * OW_EEPROM_MEMORY_PAGE_SIZE], pData, PageCount * OW_EEPROM_MEMORY_PAGE_SIZE);
+            pImage->ValidPages |= (uint8_t)(((1u << PageCount) - 1u) << Page);
+        }
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/* ========================================================================== */
+/**
+ * \brief   1-Wire device registry listener
+ *
+ * \details Invalidates the memory image of a device removed from or added to
+ *          the 1-Wire registry, as the device may have been written elsewhere
+ *          meanwhile. The next read of the device is from the bus.
+ *
+ * \param   Event - 1-Wire event
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void OwEepromDeviceEvent(ONEWIRE_EVENT Event, ONEWIRE_DEVICE_ID Device)
+{
+    if ((ONEWIRE_EVENT_LOST_DEVICE == Event) || (ONEWIRE_EVENT_NEW_DEVICE == Event))
+    {
+        OwEepromImageUpdate(Device, 0, OW_EEPROM_NUM_PAGES, NULL, false);
+    }
+}
+#endif
+
 /******************************************************************************/
 /*                             Global Function(s)                             */
 /******************************************************************************/
@@ -294,18 +525,48 @@ static OW_EEP_STATUS OwFrameTransfer(ONEWIREFRAME *pFrame)
  *
  * ========================================================================== */
 OW_EEP_STATUS L3_OneWireEepromRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t *pBuffer)
+{
+    return L3_OneWireEepromReadPages(Device, Page, 1, pBuffer);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Reads consecutive pages from 1 Wire EEPROM device
+ *
+ * \details This function reads the pages in one transfer, using the device's
+ *          continuous read: after the CRC of a page, the device sends the next
+ *          page. The device is checked and selected once for all the pages,
+ *          and each page is verified with its own CRC. The pages are always
+ *          read from the device, so this is the read to verify a write with.
+ *
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ * \param   Page - First EEPROM page number.
+ * \param   PageCount - Number of pages to read.
+ * \param   pBuffer - Buffer to store data, PageCount * OW_EEPROM_MEMORY_PAGE_SIZE bytes.
+ *
+ * \return  OW_EEP_STATUS - Status
+ *
+ * ========================================================================== */
+OW_EEP_STATUS L3_OneWireEepromReadPages(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pBuffer)
 {
     OW_EEP_STATUS Status;               /* Variable to hold the Eeprom return status value */
     ONEWIREFRAME EepromFrame;           /* Frame to hold all the packets used for tranmitting to OneWire Master */
     ONEWIREPACKET* pPacket;             /* Pointer to OneWire packet used while constructing the packets and adding to EepromFrame */
     uint8_t SendBuffer[OW_EEPROM_CMD_PACKET_SIZE];  /* Buffer used to send the command and paramter byte  */
-    uint8_t CrcBuffer[OW_EEPROM_CRC_BUF_SIZE];      /* Buffer used to hold the CRC bytes received  */
+    uint8_t CrcBuffer[OW_EEPROM_NUM_PAGES][OW_EEPROM_CRC_BUF_SIZE];  /* Buffers used to hold the CRC bytes received for each page */
     uint8_t *pBuf;                                  /* Helper  */
     uint16_t Crc16Val;                              /* Variable used to hold the CRC value computed on the data received */
+    uint8_t Index;                                  /* Page index in the read */
+#ifdef OW_EEPROM_CACHE
+    uint32_t ImageGen;                              /* Image generation at the start of the read */
+
+    ImageGen = OwEepromImageGenGet();
+#endif
 
     do
     {
-        if ((NULL == pBuffer) || (OW_EEPROM_NUM_PAGES <= Page))
+        if ((NULL == pBuffer) || (0 == PageCount) || (OW_EEPROM_NUM_PAGES < PageCount) ||
+            ((OW_EEPROM_NUM_PAGES - PageCount) < Page))
         {
             Status = OW_EEP_STATUS_PARAM_ERROR;
             Log(ERR, "L3_OneWireEepromRead: Invalid Parameter");
@@ -329,22 +590,25 @@ OW_EEP_STATUS L3_OneWireEepromRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8
         pPacket = &EepromFrame.Packets[0];
         pPacket->pTxData = SendBuffer;
         pPacket->nTxSize = OW_EEPROM_CMD_PACKET_SIZE;
-        pPacket->pRxData = CrcBuffer;
+        pPacket->pRxData = CrcBuffer[0];
         pPacket->nRxSize = OW_EEPROM_CRC_BUF_SIZE;
 
-        /* Prepare Packet to receive the data (32 Bytes data) */
-        pPacket++;
-        pPacket->pTxData = NULL;
-        pPacket->nTxSize = 0;
-        pPacket->pRxData = pBuffer;
-        pPacket->nRxSize = OW_EEPROM_MEMORY_PAGE_SIZE;
+        for (Index = 0; Index < PageCount; Index++)
+        {
+            /* Prepare Packet to receive the data (32 Bytes data) */
+            pPacket++;
+            pPacket->pTxData = NULL;
+            pPacket->nTxSize = 0;
+            pPacket->pRxData = &pBuffer[Index * OW_EEPROM_MEMORY_PAGE_SIZE];
+            pPacket->nRxSize = OW_EEPROM_MEMORY_PAGE_SIZE;
 
-        /* Prepare Packet to receive the CRC bytes (2 Bytes CRC) */
-        pPacket++;
-        pPacket->pTxData = NULL;
-        pPacket->nTxSize = 0;
-        pPacket->pRxData = CrcBuffer;
-        pPacket->nRxSize = OW_EEPROM_CRC_BUF_SIZE;
+            /* Prepare Packet to receive the CRC bytes (2 Bytes CRC) */
+            pPacket++;
+            pPacket->pTxData = NULL;
+            pPacket->nTxSize = 0;
+            pPacket->pRxData = CrcBuffer[Index];
+            pPacket->nRxSize = OW_EEPROM_CRC_BUF_SIZE;
+        }
 
         /* Mark end of frame by adding invalid packet */
         pPacket++;
@@ -362,15 +626,24 @@ OW_EEP_STATUS L3_OneWireEepromRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8
 
         /* Computing the CRC on 34 bytes (32 data bytes + 2 CRC bytes), the resultant CRC value should be 0xB001 for a valid read */
         /* Refer to https://www.maximintegrated.com/en/design/technical-documents/app-notes/2/27.html for CRC computation */
-        //Crc16Val = CRC16(0, ReadBuffer, OW_EEPROM_RD_PACKET_SIZE);
-        Crc16Val = CRC16(0, pBuffer, OW_EEPROM_MEMORY_PAGE_SIZE);
-        Crc16Val = CRC16(Crc16Val, CrcBuffer, OW_EEPROM_CRC_BUF_SIZE);
+        for (Index = 0; Index < PageCount; Index++)
+        {
+            Crc16Val = CRC16(0, &pBuffer[Index * OW_EEPROM_MEMORY_PAGE_SIZE], OW_EEPROM_MEMORY_PAGE_SIZE);
+            Crc16Val = CRC16(Crc16Val, CrcBuffer[Index], OW_EEPROM_CRC_BUF_SIZE);
+
+            if (OW_EEPROM_CRC_CONST_VAL != Crc16Val)
+            {
+                Status = OW_EEP_STATUS_ERROR;
+                Log(ERR, "L3_OneWireEepromRead: CRC check failed on the read data, page %d", Page + Index);
+            }
+        }
 
-        if (OW_EEPROM_CRC_CONST_VAL != Crc16Val)
+#ifdef OW_EEPROM_CACHE
+        if (OW_EEP_STATUS_OK == Status)
         {
-            Status = OW_EEP_STATUS_ERROR;
-            Log(ERR, "L3_OneWireEepromRead: CRC check failed on the read data");
+            OwEepromImageFill(Device, Page, PageCount, pBuffer, ImageGen);
         }
+#endif
 
         TM_Hook(HOOK_ONEWIRECRCTEST, pBuffer);
 
@@ -380,11 +653,69 @@ OW_EEP_STATUS L3_OneWireEepromRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8
     return Status;
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Reads consecutive pages from 1 Wire EEPROM device, using its memory image
+ *
+ * \details The device presence is checked on the bus, then the pages are
+ *          taken from the device memory image if it holds them, else read
+ *          from the device with L3_OneWireEepromReadPages. The image holds
+ *          the data last read or successfully written, so this read must not
+ *          be used to verify a write.
+ *
+ * \param   Device - 64 Bit 1-Wire ROM ID.
+ * \param   Page - First EEPROM page number.
+ * \param   PageCount - Number of pages to read.
+ * \param   pBuffer - Buffer to store data, PageCount * OW_EEPROM_MEMORY_PAGE_SIZE bytes.
+ *
+ * \return  OW_EEP_STATUS - Status
+ *
+ * ========================================================================== */
+OW_EEP_STATUS L3_OneWireEepromReadCached(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pBuffer)
+{
+    OW_EEP_STATUS Status;               /* Variable to hold the Eeprom return status value */
+
+    do
+    {
+#ifdef OW_EEPROM_CACHE
+        if ((NULL == pBuffer) || (0 == PageCount) || (OW_EEPROM_NUM_PAGES < PageCount) ||
+            ((OW_EEPROM_NUM_PAGES - PageCount) < Page))
+        {
+            Status = OW_EEP_STATUS_PARAM_ERROR;
+            Log(ERR, "L3_OneWireEepromReadCached: Invalid Parameter");
+            break;
+        }
+
+        if(ONEWIRE_STATUS_OK != L3_OneWireDeviceCheck(Device))
+        {
+            Status = OW_EEP_STATUS_DEVICE_NOT_FOUND;
+            Log(ERR, "L3_OneWireEepromReadCached: Device check failed");
+            break;
+        }
+
+        if (OwEepromImageRead(Device, Page, PageCount, pBuffer))
+        {
+            Status = OW_EEP_STATUS_OK;
+            TM_Hook(HOOK_ONEWIRECRCTEST, pBuffer);
+            break;
+        }
+#endif
+
+        Status = L3_OneWireEepromReadPages(Device, Page, PageCount, pBuffer);
+
+    } while(false);
+
+    return Status;
+}
+
 /* ========================================================================== */
 /**
  * \brief   Writes data to 1 Wire EEPROM device
  *
  * \details This function writes data to specified 1-Wire EEPROM device.
+ *          The device memory image is written through: it holds the page
+ *          data if the write succeeded, otherwise the page is re-read from
+ *          the device by the next L3_OneWireEepromReadCached.
  *
  * \param   Device - 64 Bit 1-Wire ROM ID.
  * \param   Page - EEPROM page number.
@@ -474,6 +805,10 @@ OW_EEP_STATUS L3_OneWireEepromWrite(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint
             Log(ERR, "L3_OneWireEepromWrite: Memory block is write protected or Authentication required");
         }
 
+#ifdef OW_EEPROM_CACHE
+        OwEepromImageUpdate(Device, Page, 1, pData, (OW_EEP_STATUS_OK == Status));
+#endif
+
     } while(false);
 
 
@@ -521,6 +856,7 @@ OW_EEP_STATUS L3_OneWireEepromErase(ONEWIRE_DEVICE_ID Device)
     return Status;
 }
 
+
 /**
  * \}  <If using addtogroup above>
  */
@@ -30,6 +30,10 @@ extern "C" {
 #define OW_EEPROM_RDWR_MAX_RETRY (3u)   ///< Max retry count value.
 #define OW_EEPROM_MEMORY_PAGE_SIZE      (32u)           ///< Memory Page Size.
 
+/* With OW_EEPROM_CACHE defined, a RAM image of each device's memory is kept once read or
+   written, so that L3_OneWireEepromReadCached does not read the device memory again. */
+#define OW_EEPROM_CACHE
+
 /******************************************************************************/
 /*                             Global Type(s)                                 */
 /******************************************************************************/
@@ -51,6 +55,8 @@ typedef enum                        /// 1-Wire EEPROM status
 /******************************************************************************/
 extern OW_EEP_STATUS L3_OneWireEepromWrite(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t *pData);
 extern OW_EEP_STATUS L3_OneWireEepromRead(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t *pBuffer);
+extern OW_EEP_STATUS L3_OneWireEepromReadPages(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pBuffer);
+extern OW_EEP_STATUS L3_OneWireEepromReadCached(ONEWIRE_DEVICE_ID Device, uint8_t Page, uint8_t PageCount, uint8_t *pBuffer);
 extern OW_EEP_STATUS L3_OneWireEepromErase(ONEWIRE_DEVICE_ID Device);
 
 /**
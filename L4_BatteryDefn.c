@@ -114,8 +114,7 @@ static AM_STATUS BatteryEepRead(void)
     CalcCRC = 0;
     pData = (uint8_t*)&BatteryInterface.Data;
 
-    OwEepStatus  = L3_OneWireEepromRead(BatteryAddress, 0, pData);
-    OwEepStatus |= L3_OneWireEepromRead(BatteryAddress, 1, pData + OW_EEPROM_MEMORY_PAGE_SIZE);
+    OwEepStatus = L3_OneWireEepromReadCached(BatteryAddress, 0, 2, pData);
 
     do
     {
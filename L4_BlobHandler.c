@@ -51,9 +51,9 @@ extern "C"
 #define BLOB_VERSION_1              (1u)                 ///< Blob Version-1
 #define BLOB_VERSION_2              (2u)                 ///< Blob Version-2
 #define LOOPCOUNTER_200             (200u)               ///< Loop delay, currently set to 100KB (200*512)
+#define BLOB_SESSION_BUF_SIZE       (8u * FILE_DATA_MAX_SIZE)   ///< Write session buffer. Multiple of the SD sector size.
 
 #define FLASHPROGRAM_AREA2_END                  (0x1007D000u)
-#define FLASHMEMORY_CRCCHECK_CHUNKSIZE          (256u)              ///< Flash Memory chunk to test in Kilo Byte
 
 #define ROUNDUPPOWEROF2(Number,Multiple)     ( ((Number)+((Multiple)-1)) & (~((Multiple)-1)) )
 #define ROUNDDOWNPOWEROF2(Number,Multiple)   ( (Number) & (~((Multiple)-1)) )
@@ -69,6 +69,15 @@ typedef enum                            ///<  Flash Section Validation States
     FLASH_CRCCCHECK_END                  ///<  END OF FLASH VALIDATE
 } FLASH_CRCCHECK_STATE;
 
+typedef struct                          ///<  Blob write session
+{
+    FS_FILE  *pFile;                    ///<  Blob file, NULL if no session is open
+    uint32_t FileSize;                  ///<  Bytes written to the file
+    uint32_t BufCount;                  ///<  Bytes held in BlobSessionBuf
+    uint32_t Checksum;                  ///<  Running CRC32 of the data following the blob checksum
+    bool     Committed;                 ///<  File holds exactly the committed session data, Checksum is valid for it
+} BLOB_WRITE_SESSION;
+
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
 /******************************************************************************/
@@ -88,6 +97,11 @@ static uint8_t             fileData[FILE_DATA_MAX_SIZE + (4*IV_OFFSET)]; //get m
 
 #pragma location=".sram"
 static uint8_t TempBuffer[3*AES_BLOCKLEN];
+
+static BLOB_WRITE_SESSION  BlobSession;                    ///< Blob write session
+
+#pragma location=".sram"
+static uint8_t             BlobSessionBuf[BLOB_SESSION_BUF_SIZE];   ///< Session data not yet written to the file
 /******************************************************************************/
 /*                             Local Function Prototype(s)                    */
 /******************************************************************************/
@@ -99,14 +113,77 @@ static BLOB_HANDLER_STATUS L4_UpdateFlashActiveVersion(void);
 #ifdef PRINT_BLOB_POINTERS /*debug purpose */
 static BLOB_HANDLER_STATUS PrintBlobPointers (BLOB_POINTERS *pBlobPointers);
 #endif
-static bool FlashFinalCrcCalculation( uint32_t TotalFlashCodesize, uint32_t HandleLowAddress, CRC_INFO *pCrcHanlde);
-static bool ValidateFlashForTwoSections(CRC_INFO *pCrcHandle, ACTIVEVERSION_2 *pActiveVersions);
+static BLOB_HANDLER_STATUS BlobSessionFlush(void);
+static void BlobSessionClose(void);
 
 
 /******************************************************************************/
 /*                             Local Function(s)                              */
 /******************************************************************************/
 
+/* ========================================================================== */
+/**
+ * \brief   Writes the buffered blob session data to the Blob file
+ *
+ * \details Called with the Blob mutex held. The buffer is only written when it
+ *          is full or the session is committed, so writes stay sector aligned.
+ *
+ * \param   < None >
+ *
+ * \return  BLOB_HANDLER_STATUS - Blob Handler return status
+ * \retval  See L4_BlobHandler.h
+ *
+ * ========================================================================== */
+static BLOB_HANDLER_STATUS BlobSessionFlush(void)
+{
+    BLOB_HANDLER_STATUS Status;  /* Error status of the function */
+    FS_ERR   FsError;            /* contains the File System error status */
+    uint32_t BytesWritten;       /* Number of bytes written as returned by File system calls */
+
+    Status = BLOB_STATUS_OK;
+
+    do
+    {
+        BREAK_IF (0 == BlobSession.BufCount);
+
+        FsError = FsWrite (BlobSession.pFile, BlobSessionBuf, BlobSession.BufCount, &BytesWritten);
+        if ((FS_ERR_NONE != FsError) || (BytesWritten != BlobSession.BufCount))
+        {
+            Log (ERR, "BlobSessionFlush: FsWrite Error %d, BytesToWrite %d BytesWritten %d", FsError, BlobSession.BufCount, BytesWritten);
+            Status = BLOB_STATUS_ERROR;
+            break;
+        }
+
+        BlobSession.FileSize += BlobSession.BufCount;
+        BlobSession.BufCount = 0;
+
+    } while (false);
+
+    return Status;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Closes the blob write session file
+ *
+ * \details Called with the Blob mutex held. Buffered data is discarded.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void BlobSessionClose(void)
+{
+    if (NULL != BlobSession.pFile)
+    {
+        FsClose (BlobSession.pFile);
+    }
+    BlobSession.pFile = NULL;
+    BlobSession.BufCount = 0;
+    BlobSession.Committed = false;
+}
+
 /* ========================================================================== */
 /**
  * \brief   Reads the Blob pointers from SD Card BLobfile.
@@ -860,103 +937,6 @@ static BLOB_HANDLER_STATUS PrintBlobPointers (BLOB_POINTERS *pBlobPointers)
 /******************************************************************************/
 /*                             Global Function(s)                             */
 /******************************************************************************/
-/* ========================================================================== */
-/**
- * \brief   Calculates CRC of memory chunk, returns CRC validation completion status
- *
- * \details This call is used calculate Flash Area CRC in chunks.
- *
- *
- * \param   TotalFlashCodesize       - total size of flash area
- *          HandleLowAddress         - Flash area lower address
- *          crcHandle                - crc Info
- * \return  Total memory CRC calculation status
- *          true : Program flash area CRC is calculated for entire region
- *          false: Program flash CRC calculation not completed
- * ========================================================================== */
-static bool FlashFinalCrcCalculation( uint32_t TotalFlashCodesize, uint32_t HandleLowAddress, CRC_INFO *CrcHandle)
-{
-    uint32_t   Memorysize;
-    uint32_t   Offset;
-    bool       IsFinalCrcCalc;
-
-    /* Initialize return status with false*/
-    IsFinalCrcCalc = false;
-
-    /* Memory chunk to calculate CRC */
-    Memorysize = FLASHMEMORY_CRCCHECK_CHUNKSIZE;
-
-    /* Last chunk might be < MEMORY_TEST_FLASH_SIZE(1024) */
-    if ( CrcHandle->CrcCalculatedMemSize + Memorysize > TotalFlashCodesize )
-    {
-        Memorysize = TotalFlashCodesize - CrcHandle->CrcCalculatedMemSize;
-    }
-
-    /* Calculate offset address */
-    Offset   =  HandleLowAddress + CrcHandle->CrcCalculatedMemSize;
-
-    /* Calculate CRC for chunk */
-    CrcHandle->CrcCalculated  = CRC32(CrcHandle->CrcCalculated, (uint8_t*)Offset, Memorysize);
-
-    /* Update CRC calculated memory size */
-    CrcHandle->CrcCalculatedMemSize += Memorysize;
-
-    /* Is CRC calculated for entire memory area */
-    if ( CrcHandle->CrcCalculatedMemSize == TotalFlashCodesize )
-    {
-        /* CRC calculation is complete, update status as completed*/
-        IsFinalCrcCalc = true;
-    }
-
-    /* return FinalCrc done status */
-    return IsFinalCrcCalc;
-}
-
-/* ========================================================================== */
-/**
- * \brief   Calculates CRC of Program Area1, Program Area2
- *
- * \details When Program Area1, Area2 has code. Calculate CRC of Program Area1 and Parse it to Program Area2 CRC calculation.
- *
- *
- *
- * \param   pActiveVersions          - Metadata Info
- *          crcHandle                - crc Info
- * \return  Total memory CRC calculation status
- *          true : Program flash area CRC is calculated for entire region
- *          false: Program flash CRC calculation not completed
- * ========================================================================== */
-static bool ValidateFlashForTwoSections(CRC_INFO *pCrcHandle, ACTIVEVERSION_2 *pActiveVersions)
-{
-    uint32_t TotalFlashCodesize;
-    bool     IsFinalCrcCalc;
-
-    IsFinalCrcCalc = false;
-    /* Main App is in Program Area1, Area2. Calculate Area1 checksum and Parse Area1 checksum to Area2*/
-    if ( (pCrcHandle->CrcCalculatedMemSize < pActiveVersions->HandleHighAddress1 - pActiveVersions->HandleLowAddress1) && !pCrcHandle->Area1CrcDone )
-    {
-        TotalFlashCodesize = pActiveVersions->HandleHighAddress1 - pActiveVersions->HandleLowAddress1;
-
-        /* Calculate CRC for Program Area 1 */
-        pCrcHandle->Area1CrcDone = FlashFinalCrcCalculation (TotalFlashCodesize,pActiveVersions->HandleLowAddress1, pCrcHandle);
-
-        /* Is AREA1 CRC calculated */
-        if ( pCrcHandle->Area1CrcDone )
-        {
-            /* Clear crc calcuated memory size. Parse calculated CRC to AREA2 */
-            pCrcHandle->CrcCalculatedMemSize = 0;
-        }
-    }
-    else
-    {
-        /* Calculate Program Area2 crc with parsed CRC from Program Area1. Remove Header, ProgramBlock size from total size */
-        TotalFlashCodesize = pActiveVersions->HandleHighAddress2 - pActiveVersions->HandleLowAddress2;
-        IsFinalCrcCalc     = FlashFinalCrcCalculation (TotalFlashCodesize,pActiveVersions->HandleLowAddress2, pCrcHandle);
-    }
-
-   return IsFinalCrcCalc;
-}
-
 /* ========================================================================== */
 /**
  * \brief   Initialization of Blob Handler
@@ -1095,6 +1075,9 @@ BLOB_HANDLER_STATUS L4_BlobErase(uint16_t *pFsError)
         /* Mutex Lock */
         OSMutexPend (pMutexBlobHandler, OS_WAIT_FOREVER, &OsErr);
 
+        /* Drop any write session on the file being deleted */
+        BlobSessionClose ();
+
         /* Delete the Blob File on the SD Card */
         FsError = FsDelete (BLOB_FILE_NAME);
 
@@ -1220,6 +1203,7 @@ BLOB_HANDLER_STATUS L4_BlobWrite (uint8_t *pData, uint32_t Offset, uint32_t NumO
 
         /* FsWrite is success at this stage and any write would have impacted the integrity of the file -  invalidating BlobValidationStatus */
         noInitRam.BlobValidationStatus = BLOB_VALIDATION_STATUS_UNKNOWN;
+        BlobSession.Committed = false;
         if (BytesWritten != NumOfBytes)
         {
             Log (ERR, "L4_BlobWrite: FsWrite Error NumOfBytes to Write %d BytesWritten %d", NumOfBytes,BytesWritten);
@@ -1240,6 +1224,236 @@ BLOB_HANDLER_STATUS L4_BlobWrite (uint8_t *pData, uint32_t Offset, uint32_t NumO
     return Status;
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Starts a Blob write session
+ *
+ * \details Opens (and truncates) the Blob file and keeps it open for the
+ *          L4_BlobWriteAppend calls that follow, until L4_BlobWriteCommit or
+ *          L4_BlobWriteAbort. An open session is abandoned.
+ *
+ * \param   < None >
+ *
+ * \return  BLOB_HANDLER_STATUS - Blob Handler return status
+ * \retval  See L4_BlobHandler.h
+ *
+ * ========================================================================== */
+BLOB_HANDLER_STATUS L4_BlobWriteBegin(void)
+{
+    BLOB_HANDLER_STATUS Status;  /* Error status of the function */
+    FS_ERR   FsError;            /* contains the File System error status */
+    uint8_t  OsErr;              /* Contains status of OS error */
+
+    Status = BLOB_STATUS_ERROR;
+
+    do
+    {
+        /* Mutex Lock */
+        OSMutexPend (pMutexBlobHandler, BLOB_MUTEX_TIMEOUT, &OsErr);
+        if (OS_ERR_NONE != OsErr)
+        {
+            Log (ERR, "L4_BlobWriteBegin: Mutex Error ");
+            break;
+        }
+
+        BlobSessionClose ();
+
+        /* Blob contents are about to change */
+        noInitRam.BlobValidationStatus = BLOB_VALIDATION_STATUS_UNKNOWN;
+
+        FsError = FsOpen (&BlobSession.pFile, BLOB_FILE_NAME, FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_TRUNCATE);
+        if (FS_ERR_NONE != FsError)
+        {
+            Log (ERR, "L4_BlobWriteBegin: FsOpen Error %d", FsError);
+            BlobSession.pFile = NULL;
+            break;
+        }
+
+        BlobSession.FileSize = 0;
+        BlobSession.BufCount = 0;
+        BlobSession.Checksum = 0;
+        Status = BLOB_STATUS_OK;
+
+    } while (false);
+
+    if (OS_ERR_NONE == OsErr)
+    {
+        OSMutexPost (pMutexBlobHandler);
+    }
+
+    return Status;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Appends data to the Blob write session
+ *
+ * \details Data must arrive in order. It is copied to the session buffer, which
+ *          is written to the file each time it fills, and added to the running
+ *          blob checksum (CRC32 of everything after the checksum field).
+ *
+ * \param   pData      - pointer to Data
+ * \param   Offset     - Blob file offset of the data. Must be the end of the data appended so far.
+ * \param   NumOfBytes - Number of bytes to append
+ *
+ * \return  BLOB_HANDLER_STATUS - Blob Handler return status
+ * \retval  See L4_BlobHandler.h
+ *
+ * ========================================================================== */
+BLOB_HANDLER_STATUS L4_BlobWriteAppend(uint8_t *pData, uint32_t Offset, uint32_t NumOfBytes)
+{
+    BLOB_HANDLER_STATUS Status;  /* Error status of the function */
+    uint8_t  OsErr;              /* Contains status of OS error */
+    uint32_t Skip;               /* Leading bytes not covered by the blob checksum */
+    uint32_t Count;              /* Bytes to copy to the session buffer */
+
+    Status = BLOB_STATUS_ERROR;
+    OsErr = OS_ERR_PEVENT_NULL;
+
+    do
+    {
+        if ((NULL == pData) || (NumOfBytes > FILE_WRITE_MAX_SIZE))
+        {
+            Status = BLOB_STATUS_INVALID_PARAM;
+            Log (ERR, "L4_BlobWriteAppend: Invalid Param");
+            break;
+        }
+
+        /* Mutex Lock */
+        OSMutexPend (pMutexBlobHandler, BLOB_MUTEX_TIMEOUT, &OsErr);
+        if (OS_ERR_NONE != OsErr)
+        {
+            Log (ERR, "L4_BlobWriteAppend: Mutex Error ");
+            break;
+        }
+
+        if (NULL == BlobSession.pFile)
+        {
+            Log (ERR, "L4_BlobWriteAppend: No write session");
+            break;
+        }
+
+        if (Offset != (BlobSession.FileSize + BlobSession.BufCount))
+        {
+            Status = BLOB_STATUS_INVALID_PARAM;
+            Log (ERR, "L4_BlobWriteAppend: Offset %d out of sequence, expected %d", Offset, BlobSession.FileSize + BlobSession.BufCount);
+            break;
+        }
+
+        /* The blob checksum covers everything after the checksum itself */
+        Skip = (Offset < sizeof(uint32_t)) ? MIN(sizeof(uint32_t) - Offset, NumOfBytes) : 0;
+        BlobSession.Checksum = CRC32 (BlobSession.Checksum, pData + Skip, NumOfBytes - Skip);
+
+        Status = BLOB_STATUS_OK;
+        while ((NumOfBytes > 0) && (BLOB_STATUS_OK == Status))
+        {
+            Count = MIN(NumOfBytes, BLOB_SESSION_BUF_SIZE - BlobSession.BufCount);
+            memcpy (&BlobSessionBuf[BlobSession.BufCount], pData, Count);
+            BlobSession.BufCount += Count;
+            pData += Count;
+            NumOfBytes -= Count;
+
+            if (BLOB_SESSION_BUF_SIZE == BlobSession.BufCount)
+            {
+                Status = BlobSessionFlush ();
+            }
+        }
+
+        if (BLOB_STATUS_OK != Status)
+        {
+            /* The file no longer matches the data received - the session can't continue */
+            BlobSessionClose ();
+        }
+
+    } while (false);
+
+    if (OS_ERR_NONE == OsErr)
+    {
+        OSMutexPost (pMutexBlobHandler);
+    }
+
+    return Status;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Completes the Blob write session
+ *
+ * \details Writes any buffered data and closes the Blob file. The blob still
+ *          has to be validated with L4_BlobValidate before use. The running
+ *          checksum is kept, so the next forced L4_BlobValidate does not have
+ *          to read the file back. Nothing to do if no session is open.
+ *
+ * \param   < None >
+ *
+ * \return  BLOB_HANDLER_STATUS - Blob Handler return status
+ * \retval  See L4_BlobHandler.h
+ *
+ * ========================================================================== */
+BLOB_HANDLER_STATUS L4_BlobWriteCommit(void)
+{
+    BLOB_HANDLER_STATUS Status;  /* Error status of the function */
+    uint8_t  OsErr;              /* Contains status of OS error */
+
+    Status = BLOB_STATUS_ERROR;
+
+    do
+    {
+        /* Mutex Lock */
+        OSMutexPend (pMutexBlobHandler, BLOB_MUTEX_TIMEOUT, &OsErr);
+        if (OS_ERR_NONE != OsErr)
+        {
+            Log (ERR, "L4_BlobWriteCommit: Mutex Error ");
+            break;
+        }
+
+        Status = BLOB_STATUS_OK;
+        BREAK_IF (NULL == BlobSession.pFile);
+
+        Status = BlobSessionFlush ();
+        BlobSessionClose ();
+        BREAK_IF (BLOB_STATUS_OK != Status);
+
+        BlobSession.Committed = true;
+        Log (DBG, "L4_BlobWriteCommit: %d bytes written, checksum 0x%08X", BlobSession.FileSize, BlobSession.Checksum);
+
+    } while (false);
+
+    if (OS_ERR_NONE == OsErr)
+    {
+        OSMutexPost (pMutexBlobHandler);
+    }
+
+    return Status;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Abandons the Blob write session
+ *
+ * \details Closes the Blob write session, if open, and deletes the partially
+ *          written Blob file.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L4_BlobWriteAbort(void)
+{
+    uint8_t  OsErr;              /* Contains status of OS error */
+
+    /* Mutex Lock */
+    OSMutexPend (pMutexBlobHandler, BLOB_MUTEX_TIMEOUT, &OsErr);
+    if (OS_ERR_NONE == OsErr)
+    {
+        BlobSessionClose ();
+        FsDelete (BLOB_FILE_NAME);
+        noInitRam.BlobValidationStatus = BLOB_VALIDATION_STATUS_UNKNOWN;
+        OSMutexPost (pMutexBlobHandler);
+    }
+}
+
 /* ========================================================================== */
 /**
  * \brief   Read from the Blob File in the SD Card
@@ -1344,6 +1558,8 @@ BLOB_HANDLER_STATUS L4_BlobRead (BLOB_SECTION BlobSection, uint8_t *pData, uint3
  * \details This call is used to Validate the blob using the blob checksum. Checksum is calculated by
  *          reading the blob file and compared with the blob checksum. Consumers of blob handler
  *          must validate the blob and proceed to other blob functionality.
+ *          If the file holds exactly the blob written by the last committed write
+ *          session, the session's running checksum is used instead of reading the file.
  *
  * \param   ForceCheck - if true, CRC calculation is forced for comparison.
  *                       if False, a stored Validation status is returned
@@ -1436,6 +1652,13 @@ BLOB_HANDLER_STATUS L4_BlobValidate(bool ForceCheck)
         FsError = FsSeek (pBlobFile, sizeof(uint32_t), FS_FILE_ORIGIN_START);
         FileOffset = sizeof(uint32_t);
 
+        /* Just downloaded - the write session already has the checksum over the whole blob */
+        if (BlobSession.Committed && (BlobSession.FileSize == TotalBlobSize) && (BlobFileAttrib.Size == TotalBlobSize))
+        {
+            CalculatedChecksum = BlobSession.Checksum;
+            FileOffset = TotalBlobSize;
+        }
+
         /* Calculate the checksum over the entire blob, except for the checksum itself, which is the first data item. */
         while (FileOffset < TotalBlobSize)
         {
@@ -2004,8 +2227,9 @@ FLASH_PROGRAM_STATUS L4_UpgradeHandleMainApp(void)
 /**
  * \brief   Validates Program flash Main App
  *
- * \details Calculates CRC for Program Flash Main App
- *
+ * \details Calculates CRC for Program Flash Main App, one slice per call (see
+ *          L4_FlashCrcRun). On the first call of a validation the regions of the
+ *          Main App are taken from the active version metadata.
  *
  * \param   pCrcHandle: pointer to CRC Info of Flash
  *
@@ -2016,20 +2240,25 @@ FLASH_CRCVALIDATION_STATUS L4_ValidateMainAppFromFlash(CRC_INFO *pCrcHandle)
 {
     ACTIVEVERSION_2            *pActiveVersions;
     FLASH_CRCVALIDATION_STATUS  Status;
-    bool                        IsFinalCrcCalc;
-    uint32_t                    TotalFlashCodesize;
+    FLASH_CRC_REGION            Region[FLASH_CRC_REGION_MAX];
+    uint8_t                     RegionCount;
 
     /* Initialize variables */
     pActiveVersions = (ACTIVEVERSION_2*)(ACTIVE_METADATA_NEW_START);
-    IsFinalCrcCalc = false;
+    Status = FLASH_CRCVALIDATION_UNKNOWN;
 
     do
     {
+        /* Validation already started - continue it */
+        if ( pCrcHandle->RegionCount > 0 )
+        {
+            Status = L4_FlashCrcRun (pCrcHandle);
+            break;
+        }
+
         /* Check Metadata is having valid size of program flash */
         if ( !(pActiveVersions->HandleDataSize > 0) )
         {
-            /* CRC validation has not started */
-            Status =  FLASH_CRCVALIDATION_UNKNOWN;
             /* Log Error */
             Log (ERR, "Metadata Handle Program data size is zero");
             break;
@@ -2038,8 +2267,6 @@ FLASH_CRCVALIDATION_STATUS L4_ValidateMainAppFromFlash(CRC_INFO *pCrcHandle)
         /* Check Metadata High address 2 is within FLASH PROGRAM AREA2 END */
         if ( !( pActiveVersions->HandleHighAddress2 < FLASHPROGRAM_AREA2_END ) )
         {
-            /* CRC validation has not started */
-            Status =  FLASH_CRCVALIDATION_UNKNOWN;
             /* Log Error */
             Log(ERR, "Metadata Area2 address: %x is greater than FLASH Program Area2", pActiveVersions->HandleHighAddress2);
             break;
@@ -2048,48 +2275,194 @@ FLASH_CRCVALIDATION_STATUS L4_ValidateMainAppFromFlash(CRC_INFO *pCrcHandle)
         /* Check Metadata Low Address1 is less than High Address1*/
         if ( !( pActiveVersions->HandleLowAddress1 < pActiveVersions->HandleHighAddress1 ) )
         {
-            /* CRC validation has not started */
-            Status =  FLASH_CRCVALIDATION_UNKNOWN;
             /* Log Error */
             Log (ERR, "Metadata Area1 Low address: %x is greater than Metadata High Address1: %x", pActiveVersions->HandleLowAddress1, pActiveVersions->HandleHighAddress1 );
             break;
         }
 
-        /* Update status as VALIDATING */
-        Status = FLASH_CRCVALIDATION_INPROGRESS;
+        Region[0].Address = pActiveVersions->HandleLowAddress1;
 
         /* Main App is only at PROGRAM AREA 1*/
         if ( 0 == pActiveVersions->HandleHighAddress2 )
         {
             /* calculate actual flash code size. Remove Header, ProgramBlock size from total size */
-            TotalFlashCodesize = pActiveVersions->HandleDataSize - sizeof (BINARY_HEADER) - sizeof (PROGRAM_BLOCK_INFO);
-            /* Calculate CRC for chunk by parsing calculated CRC */
-            IsFinalCrcCalc = FlashFinalCrcCalculation (TotalFlashCodesize,pActiveVersions->HandleLowAddress1, pCrcHandle);
+            Region[0].Size = pActiveVersions->HandleDataSize - sizeof (BINARY_HEADER) - sizeof (PROGRAM_BLOCK_INFO);
+            RegionCount = 1;
         }
         else
         {
-            IsFinalCrcCalc = ValidateFlashForTwoSections (pCrcHandle, pActiveVersions);
+            /* Main App is in Program Area1, Area2. Area1 CRC is carried on into Area2 */
+            Region[0].Size    = pActiveVersions->HandleHighAddress1 - pActiveVersions->HandleLowAddress1;
+            Region[1].Address = pActiveVersions->HandleLowAddress2;
+            Region[1].Size    = pActiveVersions->HandleHighAddress2 - pActiveVersions->HandleLowAddress2;
+            RegionCount = 2;
         }
 
-        /* Is final CRC calculated */
-        if( IsFinalCrcCalc )
-        {
-            /* Reset Area1 CRC check */
-            pCrcHandle->Area1CrcDone = false;
-            TM_Hook(HOOK_FLASH_INTEGRITY_SIMULATE, (void *)(&pCrcHandle));
-            /* Compare calculated CRC with stored CRC */
-            Status = ( pCrcHandle->CrcCalculated == pActiveVersions->HandleChecksum ) ? FLASH_CRC_VALIDATED_GOOD:FLASH_CRC_VALIDATED_BAD;
-            /* Clear calculated CRC */
-            pCrcHandle->CrcCalculated        = 0;
-            /* Clear memory size of calculated area */
-            pCrcHandle->CrcCalculatedMemSize = 0;
-        }
+        BREAK_IF (BLOB_STATUS_OK != L4_FlashCrcStart (pCrcHandle, Region, RegionCount, pActiveVersions->HandleChecksum));
+
+        Status = L4_FlashCrcRun (pCrcHandle);
+
     } while ( false );
 
     /* Return CRC validation status */
     return Status;
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Starts a flash CRC validation
+ *
+ * \details Sets up the CRC Info checkpoint to validate the given flash regions
+ *          against a CRC32. The regions are CRC'd in order, as one image. The
+ *          validation is then run by calls to L4_FlashCrcRun. Any validation in
+ *          progress on this CRC Info is discarded.
+ * \n \n
+ *          Each validation needs its own CRC Info, so a validation of other
+ *          regions can run alongside the Main App validation.
+ *
+ * \param   pCrcHandle  - pointer to CRC Info. ChunkSize and SliceTime are kept; 0 selects the default.
+ * \param   pRegion     - pointer to regions to validate
+ * \param   RegionCount - number of regions (1 to FLASH_CRC_REGION_MAX)
+ * \param   ExpectedCrc - CRC32 the regions must match
+ *
+ * \return  BLOB_HANDLER_STATUS
+ * \retval  BLOB_STATUS_OK            - Validation started
+ * \retval  BLOB_STATUS_INVALID_PARAM - Bad parameter
+ *
+ * ========================================================================== */
+BLOB_HANDLER_STATUS L4_FlashCrcStart(CRC_INFO *pCrcHandle, const FLASH_CRC_REGION *pRegion, uint8_t RegionCount, uint32_t ExpectedCrc)
+{
+    BLOB_HANDLER_STATUS Status;
+    uint8_t             Index;
+
+    Status = BLOB_STATUS_INVALID_PARAM;
+
+    do
+    {
+        BREAK_IF ((NULL == pCrcHandle) || (NULL == pRegion));
+        BREAK_IF ((0 == RegionCount) || (RegionCount > FLASH_CRC_REGION_MAX));
+
+        for (Index = 0; Index < RegionCount; Index++)
+        {
+            pCrcHandle->Region[Index] = pRegion[Index];
+        }
+
+        if (0 == pCrcHandle->ChunkSize)
+        {
+            pCrcHandle->ChunkSize = FLASH_CRC_CHUNK_SIZE_DEFAULT;
+        }
+
+        if (0 == pCrcHandle->SliceTime)
+        {
+            pCrcHandle->SliceTime = FLASH_CRC_SLICE_TIME_DEFAULT;
+        }
+
+        pCrcHandle->CrcCalculated        = 0;
+        pCrcHandle->CrcCalculatedMemSize = 0;
+        pCrcHandle->RegionIdx            = 0;
+        pCrcHandle->RegionCount          = RegionCount;
+        pCrcHandle->ExpectedCrc          = ExpectedCrc;
+        pCrcHandle->StartTime            = SigTime();
+
+        Status = BLOB_STATUS_OK;
+
+    } while (false);
+
+    return Status;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Runs a slice of a flash CRC validation
+ *
+ * \details Continues the validation started by L4_FlashCrcStart from its
+ *          checkpoint. CRCs ChunkSize bytes at a time until all regions are
+ *          done, or SliceTime has been spent (at least one chunk is done per
+ *          call). The checkpoint is updated after each chunk.
+ * \n \n
+ *          When all regions are done the CRC is compared, ValidationTime and
+ *          ValidationSize are updated, and the CRC Info returns to idle.
+ *
+ * \param   pCrcHandle - pointer to CRC Info
+ *
+ * \return  FLASH_CRCVALIDATION_STATUS
+ * \retval  FLASH_CRCVALIDATION_UNKNOWN    - No validation started
+ * \retval  FLASH_CRCVALIDATION_INPROGRESS - Slice done, more to do
+ * \retval  FLASH_CRC_VALIDATED_GOOD       - CRC matched
+ * \retval  FLASH_CRC_VALIDATED_BAD        - CRC did not match
+ *
+ * ========================================================================== */
+FLASH_CRCVALIDATION_STATUS L4_FlashCrcRun(CRC_INFO *pCrcHandle)
+{
+    FLASH_CRCVALIDATION_STATUS  Status;
+    FLASH_CRC_REGION            *pRegion;
+    uint32_t                    SliceStart;
+    uint32_t                    Memorysize;
+    uint32_t                    Chunks;
+    uint32_t                    Index;
+
+    Status = FLASH_CRCVALIDATION_UNKNOWN;
+    Chunks = 0;
+
+    do
+    {
+        BREAK_IF ((NULL == pCrcHandle) || (0 == pCrcHandle->RegionCount));
+
+        Status     = FLASH_CRCVALIDATION_INPROGRESS;
+        SliceStart = SigTime();
+
+        while (pCrcHandle->RegionIdx < pCrcHandle->RegionCount)
+        {
+            pRegion = &pCrcHandle->Region[pCrcHandle->RegionIdx];
+
+            if (pCrcHandle->CrcCalculatedMemSize >= pRegion->Size)
+            {
+                /* Region done. Carry the CRC on into the next region */
+                pCrcHandle->RegionIdx++;
+                pCrcHandle->CrcCalculatedMemSize = 0;
+                continue;
+            }
+
+            BREAK_IF ((Chunks > 0) && ((SigTime() - SliceStart) >= pCrcHandle->SliceTime));
+
+            /* Last chunk of the region might be short */
+            Memorysize = pRegion->Size - pCrcHandle->CrcCalculatedMemSize;
+            if (Memorysize > pCrcHandle->ChunkSize)
+            {
+                Memorysize = pCrcHandle->ChunkSize;
+            }
+
+            pCrcHandle->CrcCalculated = CRC32 (pCrcHandle->CrcCalculated, (uint8_t *)(pRegion->Address + pCrcHandle->CrcCalculatedMemSize), Memorysize);
+            pCrcHandle->CrcCalculatedMemSize += Memorysize;
+            Chunks++;
+        }
+
+        /* Slice budget spent */
+        BREAK_IF (pCrcHandle->RegionIdx < pCrcHandle->RegionCount);
+
+        TM_Hook(HOOK_FLASH_INTEGRITY_SIMULATE, (void *)(&pCrcHandle));
+
+        /* Compare calculated CRC with expected CRC */
+        Status = (pCrcHandle->CrcCalculated == pCrcHandle->ExpectedCrc) ? FLASH_CRC_VALIDATED_GOOD : FLASH_CRC_VALIDATED_BAD;
+
+        pCrcHandle->ValidationTime = SigTime() - pCrcHandle->StartTime;
+        pCrcHandle->ValidationSize = 0;
+        for (Index = 0; Index < pCrcHandle->RegionCount; Index++)
+        {
+            pCrcHandle->ValidationSize += pCrcHandle->Region[Index].Size;
+        }
+
+        /* Back to idle */
+        pCrcHandle->CrcCalculated        = 0;
+        pCrcHandle->CrcCalculatedMemSize = 0;
+        pCrcHandle->RegionIdx            = 0;
+        pCrcHandle->RegionCount          = 0;
+
+    } while (false);
+
+    return Status;
+}
+
 /* ========================================================================== */
 /**
  * \brief   validates handle app
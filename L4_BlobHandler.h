@@ -41,6 +41,10 @@ extern "C"
 #define DEVICE_PROPERTIES_MASK_BLOB_VALID             (1u) ///< Blob is valid
 #define DEVICE_PROPERTIES_MASK_ACTIVE_VERSIONS_VALID  (2u) ///< Active version is valid
 
+#define FLASH_CRC_REGION_MAX          (2u)        ///< Max flash regions covered by one CRC
+#define FLASH_CRC_CHUNK_SIZE_DEFAULT  (1024u)     ///< Default bytes per CRC32 call
+#define FLASH_CRC_SLICE_TIME_DEFAULT  (MSEC_2)    ///< Default time budget per validation slice. 0 - one chunk per slice
+
 /******************************************************************************/
 /*                             Global Type(s)                                 */
 /******************************************************************************/
@@ -260,11 +264,28 @@ typedef struct             /// Block information
     INT32U Length;             ///< Size of the block
 } PROGRAM_BLOCK_INFO;
 
-typedef struct                           ///< Crc Info
+typedef struct                           ///< Flash region covered by a CRC
+{
+  uint32_t Address;                     ///< Region start address
+  uint32_t Size;                        ///< Region size in bytes
+} FLASH_CRC_REGION;
+
+/// Crc Info. Holds the checkpoint of a flash CRC validation, so the validation
+/// can be run a slice at a time (see L4_FlashCrcRun). ChunkSize and SliceTime may
+/// be set by the caller; 0 selects the defaults.
+typedef struct
 {
-  uint32_t CrcCalculated;               ///< CRC calculated for Section
-  uint32_t CrcCalculatedMemSize;        ///< CRC calculated for Memory size
-  bool     Area1CrcDone;                ///< Area1 CRC is calculated
+  uint32_t CrcCalculated;               ///< CRC calculated so far
+  uint32_t CrcCalculatedMemSize;        ///< Bytes of the present region included in CrcCalculated
+  uint8_t  RegionIdx;                   ///< Region being validated
+  uint8_t  RegionCount;                 ///< Number of regions. 0 - no validation started
+  FLASH_CRC_REGION Region[FLASH_CRC_REGION_MAX];  ///< Regions, in CRC order
+  uint32_t ExpectedCrc;                 ///< CRC the regions must match
+  uint32_t ChunkSize;                   ///< Bytes per CRC32 call
+  uint32_t SliceTime;                   ///< Time budget per slice (mS). 0 - one chunk per slice
+  uint32_t StartTime;                   ///< Time the validation was started (mS)
+  uint32_t ValidationTime;              ///< Duration of the last completed validation (mS)
+  uint32_t ValidationSize;              ///< Bytes covered by the last completed validation
 } CRC_INFO;
 
 /******************************************************************************/
@@ -274,6 +295,10 @@ BLOB_HANDLER_STATUS 	   L4_CheckHandleBootloader(void);
 BLOB_HANDLER_STATUS 	   L4_BlobHandlerInit(void);
 BLOB_HANDLER_STATUS 	   L4_BlobErase(uint16_t *pFsError);
 BLOB_HANDLER_STATUS 	   L4_BlobWrite (uint8_t *pData, uint32_t Offset ,uint32_t NumOfBytes);
+BLOB_HANDLER_STATUS        L4_BlobWriteBegin (void);
+BLOB_HANDLER_STATUS        L4_BlobWriteAppend (uint8_t *pData, uint32_t Offset, uint32_t NumOfBytes);
+BLOB_HANDLER_STATUS        L4_BlobWriteCommit (void);
+void                       L4_BlobWriteAbort (void);
 BLOB_HANDLER_STATUS 	   L4_BlobRead (BLOB_SECTION BlobSection, uint8_t *pData, uint32_t Offset ,uint32_t DataSize, uint32_t *pBytesRead);
 BLOB_HANDLER_STATUS 	   L4_BlobValidate (bool ForceCheck);
 BLOB_HANDLER_STATUS 	   L4_BlobGetInfo (BLOB_GETINFO_PARAM ParamId, uint8_t *pData, uint16_t *pResponseSize);
@@ -289,6 +314,8 @@ uint32_t                   L4_GetBlobHandleTimestamp(void);
 MAIN_FUNC                  L4_ValidateHandleMainApp(void);
 FLASH_PROGRAM_STATUS 	   L4_UpgradeHandleMainApp(void);
 FLASH_CRCVALIDATION_STATUS L4_ValidateMainAppFromFlash(CRC_INFO *pCrcHandle);
+BLOB_HANDLER_STATUS        L4_FlashCrcStart(CRC_INFO *pCrcHandle, const FLASH_CRC_REGION *pRegion, uint8_t RegionCount, uint32_t ExpectedCrc);
+FLASH_CRCVALIDATION_STATUS L4_FlashCrcRun(CRC_INFO *pCrcHandle);
 BLOB_HANDLER_STATUS        L4_ValidateFlashActiveVersionStruct(void);
 FPGA_MGR_STATUS            L4_CheckFPGA(void);
 
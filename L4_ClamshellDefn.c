@@ -113,8 +113,7 @@ static AM_STATUS ClamshellEepRead(void)
     CalcCRC = 0;
     pData = (uint8_t*)&ClamshellInterface.Data;
 
-    OwEepStatus  = L3_OneWireEepromRead(ClamshellAddress, 0, pData);
-    OwEepStatus |= L3_OneWireEepromRead(ClamshellAddress, 1, pData + OW_EEPROM_MEMORY_PAGE_SIZE);
+    OwEepStatus = L3_OneWireEepromReadPages(ClamshellAddress, 0, 2, pData);
 
     do
     {
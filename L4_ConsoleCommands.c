@@ -25,6 +25,7 @@ extern "C"
 #include "L4_ConsoleCommands.h"
 #include "Signia_KeypadEvents.h"
 #include "L3_OneWireRtc.h"
+#include "L3_OneWireController.h"
 #include "L2_OnchipRtc.h"
 #include "FileSys.h"
 #include "Signia_Accelerometer.h"
@@ -37,6 +38,7 @@ extern "C"
 #include "TestManager.h"
 #include "Kvf.h"
 #include "DSA.h"
+#include "SHA.h"
 #include "NoInitRam.h"
 
 /******************************************************************************/
@@ -89,6 +91,7 @@ extern "C"
 #define RXBUFF_FILE_INDEX                  (6u)            ///< File name index for security log
 #define RXBUFF_FILE_NAME_INDEX             (10u)           ///< File name index in rx buff
 #define RXBUFF_DATA_START_INDEX            (8u)            ///< data start index in rx buff
+#define FILE_STREAM_IDLE_TIMEOUT           (SEC_5)         ///< Streamed file is closed after this long without a request (mS)
 
 #define FIELD_SIZEOF(t, f) (sizeof(((t*)0)->f))            ///< Size of a stucture element
 
@@ -102,6 +105,20 @@ typedef struct                                                    /*! File data
     uint8_t        WorkingFileName[FS_CFG_MAX_FULL_NAME_LEN + 1]; /*! File name to store */
 } CONS_MGR_FILE_REPO;
 
+typedef struct                                                    /*! File streamed by SERIALCMD_GET_OPEN_FILE_DATA */
+{
+    FS_FILE *      pFile;                                         /*! Open file, NULL if none */
+    uint8_t        FileName[FS_CFG_MAX_FULL_NAME_LEN + 1];        /*! Name of the open file */
+    uint32_t       FileSize;                                      /*! File size when opened */
+    uint32_t       LastOffset;                                    /*! Offset of the last chunk read */
+    uint32_t       NextOffset;                                    /*! Offset following the last chunk read */
+    uint32_t       LastAccess;                                    /*! Time of the last request (mS) */
+    bool           Sign;                                          /*! Sign the file with its last chunk */
+    bool           Complete;                                      /*! Last chunk sent - kept open to answer a repeat of it */
+    SHA256_CTX     Hash;                                          /*! Running hash of the file up to NextOffset */
+    SHA256_CTX     LastHash;                                      /*! Running hash up to LastOffset, to repeat the last chunk */
+} CONS_MGR_FILE_STREAM;
+
 typedef struct                         /*! Changeable variable data structure */
 {
    uint8_t    VarSize;                 /*! Variable size */
@@ -218,6 +235,7 @@ static char const* const SerialCmdName[] =
 };
 
 static CONS_MGR_FILE_REPO ConsFileRepo = {NULL, NULL, false, {0}};
+static CONS_MGR_FILE_STREAM ConsFileStream;                 /*! File held open across SERIALCMD_GET_OPEN_FILE_DATA requests */
 static CHANGEABLE_VAR_REPO ChangeableVarRepo = {0, false, false};
 
 static CHANGEABLE_VAR ChangeableVars[] =
@@ -318,6 +336,8 @@ static const TEMP_SIG_TABLE TempSigTable[] =
 /*                             Local Function Prototype(s)                    */
 /******************************************************************************/
 static uint16_t To16U(uint8_t *pRawData);
+static void FileStreamClose(void);
+static uint16_t OneWireOpStatsPack(uint8_t *pData, ONEWIRE_OP_STATS *pOpStats);
 /******************************************************************************/
 /*                                 Local Functions                            */
 /******************************************************************************/
@@ -869,7 +889,9 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     break;
 
                 case SERIALCMD_FORMAT_FILESYSTEM:
+                    FileStreamClose();
                     FsError = FsFormatSDCard();
+                    KvfIndexInvalidate(NULL);
                     memcpy(ResponseData, &FsError, sizeof(FsError));
                     pDataRx->TxDataCount = sizeof(FsError);
                     break;
@@ -881,7 +903,9 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     break;
 
                 case SERIALCMD_DELETE_FILE:
+                    FileStreamClose();
                     FsError = FsDelete((int8_t*)pRxData);
+                    KvfIndexInvalidate(NULL);
                     memcpy(ResponseData, &FsError, sizeof(FsError));
                     pDataRx->TxDataCount = sizeof(FsError);
                     break;
@@ -893,7 +917,9 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     
                     pOldFileName = pRxData;
                     pNewFileName = (pRxData + strlen((char*)pOldFileName) + 1);
+                    FileStreamClose();
                     FsError = FsRename((int8_t*)pOldFileName, (int8_t*)pNewFileName);
+                    KvfIndexInvalidate(NULL);
                     memcpy(ResponseData, &FsError, sizeof(FsError));
                     pDataRx->TxDataCount = sizeof(FsError);
                     break;
@@ -1006,6 +1032,7 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                         FsError = FS_ERR_NONE;
                         memcpy (&FileOffset, pRxData, sizeof(uint32_t));
                         memcpy (&PacketDataSize, pRxData + sizeof(uint32_t), sizeof(PacketDataSize));
+                        FileStreamClose();
                         FsError = FsOpen (&pTempFilePtr, (int8_t*)pConsFileRepo->WorkingFileName, FS_FILE_ACCESS_MODE_RDWR);
                         memcpy (ResponseData, &FsError, sizeof(FsError));
                         pDataRx->TxDataCount = sizeof(FsError);
@@ -1061,6 +1088,7 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                         }
 
                         FsError = FsClose(pTempFilePtr);
+                        KvfIndexInvalidate(NULL);
 
                     } while (false);
 
@@ -1138,7 +1166,26 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                   }
 
                 case SERIALCMD_ONEWIRE_GET_STATUS:
+                  {
+                    ONEWIRE_STATS  Stats;    /* 1-Wire statistics since the last request */
+                    uint32_t       Elapsed;  /* Time since the last request (mS) */
+                    uint8_t        Bus;      /* 1-Wire bus index */
+
+                    /* Respond with the 1-Wire scan, authentication and transfer timing, then restart it */
+                    L3_OneWireStatsGetAndReset(&Stats);
+                    Elapsed = SigTime() - Stats.StartTime;
+
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Elapsed, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+                    for (Bus = 0; Bus < ONEWIRE_BUS_COUNT; Bus++)
+                    {
+                        ResponseData[pDataRx->TxDataCount++] = Stats.Found[Bus];
+                        pDataRx->TxDataCount += OneWireOpStatsPack(&ResponseData[pDataRx->TxDataCount], &Stats.Scan[Bus]);
+                    }
+                    pDataRx->TxDataCount += OneWireOpStatsPack(&ResponseData[pDataRx->TxDataCount], &Stats.Authenticate);
+                    pDataRx->TxDataCount += OneWireOpStatsPack(&ResponseData[pDataRx->TxDataCount], &Stats.Transfer);
                     break;
+                  }
 
                 case SERIALCMD_ONEWIRE_WRITE_MEMORY:
                   {
@@ -1182,9 +1229,41 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     break;
 
                 case SERIALCMD_COMM_TEST_SETUP:
+                  {
+                    CONS_MGR_STATS Stats;    /* Statistics since the last setup */
+                    uint32_t       Elapsed;  /* Time since the last setup (mS) */
+
+                    /* Respond with the statistics gathered so far, then restart them for the requested command */
+                    L4_ConsoleMgrStatsGet(&Stats);
+                    Elapsed = SigTime() - Stats.StartTime;
+
+                    ResponseData[pDataRx->TxDataCount++] = Stats.Command;
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Stats.CommandCount, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Stats.RxBytes, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Stats.TxBytes, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Stats.ProcessTimeTotal, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Stats.ProcessTimeMax, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+                    memcpy(&ResponseData[pDataRx->TxDataCount], &Elapsed, sizeof(uint32_t));
+                    pDataRx->TxDataCount += sizeof(uint32_t);
+
+                    /* Optional command to measure - all commands if absent */
+                    L4_ConsoleMgrStatsStart((pDataRx->DataSize > 0) ? (SERIAL_CMD)pRxData[0] : SERIALCMD_UNKNOWN);
                     break;
+                  }
 
                 case SERIALCMD_COMM_TEST_PACKET:
+                    /* Loopback: echo the payload, to measure protocol latency and throughput */
+                    pDataRx->TxDataCount = pDataRx->DataSize;
+                    if (pDataRx->TxDataCount > (MAX_DATA_TRANSMIT_SIZE - PCKT_OVERHEAD_16BIT))
+                    {
+                        pDataRx->TxDataCount = MAX_DATA_TRANSMIT_SIZE - PCKT_OVERHEAD_16BIT;
+                    }
+                    memcpy(ResponseData, pRxData, pDataRx->TxDataCount);
                     break;
 
                 case SERIALCMD_BLOB_DATA_SETUP:
@@ -1197,6 +1276,12 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     ResponseData[pDataRx->TxDataCount++] = 0;
                     noInitRam.BlobValidationStatus = BLOB_VALIDATION_STATUS_UNKNOWN;
                     FSEntry_Del (BLOB_FILE_NAME, FS_ENTRY_TYPE_FILE, &FsError);
+                    if (BLOB_STATUS_OK != L4_BlobWriteBegin ())
+                    {
+                        /* No response - the download can't start */
+                        Log (ERR, "Blob download setup failed");
+                        pDataRx->TxDataCount = 0;
+                    }
                     break;
 
                 case SERIALCMD_BLOB_DATA_PACKET:
@@ -1224,12 +1309,17 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     PacketDataSize = PacketDataSize - DATA_OFFSET;
                     PrevDataOffset = DataOffset;
 
-                    Status = L4_BlobWrite (pRxData+DATA_OFFSET, DataOffset, PacketDataSize);
+                    Status = L4_BlobWriteAppend (pRxData+DATA_OFFSET, DataOffset, PacketDataSize);
                     if (Status == BLOB_STATUS_OK)
                     {
                         memcpy (ResponseData, &DataOffset, sizeof(DataOffset));
                         pDataRx->TxDataCount = sizeof(DataOffset);
                     }
+                    else if (Status == BLOB_STATUS_ERROR)
+                    {
+                        /* Write session lost - don't leave a partial blob behind */
+                        L4_BlobWriteAbort ();
+                    }
                     break;
                   }
 
@@ -1237,7 +1327,14 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                   {
                     uint8_t ValidationError = true; /* To store Validation status */
                     
-                    if (L4_BlobValidate(true) == BLOB_STATUS_VALIDATED)
+                    /* Write out the rest of the downloaded blob, if any. Validation uses the
+                       checksum accumulated while the blob was received. */
+                    if (BLOB_STATUS_OK != L4_BlobWriteCommit ())
+                    {
+                        /* Incomplete download - don't leave a partial blob behind */
+                        L4_BlobWriteAbort ();
+                    }
+                    else if (L4_BlobValidate(true) == BLOB_STATUS_VALIDATED)
                     {
                        	// Handle software update and status message logged in security Log
                         SecurityLog ("HANDLE software update Validated");
@@ -1660,7 +1757,132 @@ CONS_MGR_STATE ProcessCommand(PROCESSDATA *pDataRx)
                     break;
                   }
                 case SERIALCMD_GET_OPEN_FILE_DATA:
+                  {
+                    /* Streaming version of SERIALCMD_GET_FILE_DATA. Same request and response layout, but the
+                       file stays open between requests for it, and a security log is hashed as it is read and
+                       signed once, with its last chunk, instead of every chunk being signed. A security log
+                       must be read in order from offset 0; only the last chunk may be requested again. The file
+                       stays open after its last chunk, so a lost final response can be repeated, until another
+                       file is requested or the stream is idle for FILE_STREAM_IDLE_TIMEOUT. */
+                    uint32_t            FileOffset;    /* File offset */
+                    uint32_t            BytesToRead;   /* Number of bytes to read */
+                    uint32_t            BytesRead;     /* Number of bytes read */
+                    FS_ENTRY_INFO       FsInfo;        /* File attributes */
+                    uint8_t             Hash[SHA256_HASH_SIZE];   /* Hash of the whole file */
+                    uint8_t             *pFileName;    /* Requested file */
+
+                    pDataRx->TxDataCount = sizeof(FsError);
+                    FsError = FS_ERR_NONE;
+                    pFileName = pRxData + sizeof(uint32_t);
+                    do
+                    {
+                        memcpy(&FileOffset, pRxData, sizeof(uint32_t));
+
+                        /* Open the file, unless it is the one already open. A read from the start reopens it,
+                           so that the size of a file that has grown since is picked up */
+                        if ((NULL == ConsFileStream.pFile) || (DATA_OFFSET_START == FileOffset) ||
+                            (strcmp((char *)ConsFileStream.FileName, (char *)pFileName) != 0))
+                        {
+                            FileStreamClose();
+                            if (strlen((char *)pFileName) >= sizeof(ConsFileStream.FileName))
+                            {
+                                FsError = FS_ERR_NAME_INVALID;
+                                break;
+                            }
+
+                            FsError = FsOpen(&ConsFileStream.pFile, (int8_t*)pFileName, FS_FILE_ACCESS_MODE_RD);
+                            if (FS_ERR_NONE != FsError)
+                            {
+                                ConsFileStream.pFile = NULL;
+                                Log(ERR, "File open error %d", FsError);
+                                break;
+                            }
+
+                            FsError = FsGetInfo((int8_t*)pFileName, &FsInfo);
+                            if (FS_ERR_NONE != FsError)
+                            {
+                                FileStreamClose();
+                                Log(ERR, "Error in getting file attributes %d", FsError);
+                                break;
+                            }
+
+                            strcpy((char *)ConsFileStream.FileName, (char *)pFileName);
+                            ConsFileStream.FileSize = FsInfo.Size;
+                            ConsFileStream.LastOffset = 0;
+                            ConsFileStream.NextOffset = 0;
+                            ConsFileStream.Complete = false;
+                            ConsFileStream.Sign = !strncmp("securityLog",(char const*)&pRxData[RXBUFF_FILE_NAME_INDEX],strlen("securityLog"));
+                            sha256_init(&ConsFileStream.Hash);
+                            ConsFileStream.LastHash = ConsFileStream.Hash;
+                        }
+                        ConsFileStream.LastAccess = SigTime();
+
+                        /* Out of sequence request, or any request after the last chunk */
+                        if ((FileOffset != ConsFileStream.NextOffset) || ConsFileStream.Complete)
+                        {
+                            /* The hash only covers an in order read from the start, a signed file can only repeat its last chunk */
+                            if (ConsFileStream.Sign)
+                            {
+                                if (FileOffset != ConsFileStream.LastOffset)
+                                {
+                                    FileStreamClose();
+                                    FsError = FS_ERR_FILE_INVALID_OFFSET;
+                                    Log(ERR, "Signed file read out of sequence, offset %d", FileOffset);
+                                    break;
+                                }
+                                ConsFileStream.Hash = ConsFileStream.LastHash;
+                            }
+
+                            FsError = FsSeek(ConsFileStream.pFile, FileOffset, FS_FILE_ORIGIN_START);
+                            if (FS_ERR_NONE != FsError)
+                            {
+                                FileStreamClose();
+                                Log(ERR, "Error in setting file position %d", FsError);
+                                break;
+                            }
+                        }
+
+                        /* Read the file contents */
+                        BytesToRead = 0;
+                        BytesRead = 0;
+                        if (FileOffset < ConsFileStream.FileSize)
+                        {
+                            BytesToRead = MIN(ConsFileStream.FileSize - FileOffset, LARGEST_PACKET_SIZE_16BIT - FILE_SIZE_RD_OVERHEAD - PUBLIC_KEY_SIZE - SIGNATURE_SIZE);
+                            FsError = FsRead(ConsFileStream.pFile, &ResponseData[RXBUFF_DATA_START_INDEX], BytesToRead, &BytesRead);
+                            if (FS_ERR_NONE != FsError)
+                            {
+                                FileStreamClose();
+                                Log(ERR, "File read error %d", FsError);
+                                break;
+                            }
+                        }
+                        ConsFileStream.LastOffset = FileOffset;
+                        ConsFileStream.NextOffset = FileOffset + BytesRead;
+
+                        if (ConsFileStream.Sign)
+                        {
+                            ConsFileStream.LastHash = ConsFileStream.Hash;
+                            sha256_update(&ConsFileStream.Hash, &ResponseData[RXBUFF_DATA_START_INDEX], BytesRead);
+                        }
+
+                        /* Last chunk - sign the file. LastHash still covers the file up to this chunk, to sign a repeat of it */
+                        ConsFileStream.Complete = (ConsFileStream.NextOffset >= ConsFileStream.FileSize);
+                        if (ConsFileStream.Complete && ConsFileStream.Sign)
+                        {
+                            sha256_final(&ConsFileStream.Hash, Hash);
+                            ComputeHashSignature(Hash, &ResponseData[RXBUFF_DATA_START_INDEX + BytesRead]);
+                            BytesRead = BytesRead + PUBLIC_KEY_SIZE + SIGNATURE_SIZE;
+                        }
+
+                        /* Prepare a response with error code, offset, Data size and file data */
+                        memcpy(ResponseData + sizeof(FsError), &FileOffset, sizeof(FileOffset));
+                        memcpy(ResponseData + sizeof(FsError) + sizeof(FileOffset), (uint16_t *)&BytesRead, sizeof(uint16_t));
+                        pDataRx->TxDataCount = sizeof(FsError) + sizeof(FileOffset) + sizeof(uint16_t) + (uint16_t)BytesRead;
+                    } while (false);
+
+                    memcpy(ResponseData, &FsError, sizeof(FsError));
                     break;
+                  }
 
                 default:
                     ConsoleTaskNextState = CONS_MGR_STATE_WAIT_FOR_EVENT;
@@ -1690,9 +1912,96 @@ static uint16_t To16U(uint8_t *pRawData)
     return (((uint16_t) pRawData[1] << BITS_8) | ((uint16_t)pRawData[0]));
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Closes the streamed file
+ *
+ * \details Closes the file held open by SERIALCMD_GET_OPEN_FILE_DATA, if any.
+ *          Called before file system commands that could change or remove it,
+ *          on errors, and when the download is abandoned.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ * ========================================================================== */
+static void FileStreamClose(void)
+{
+    if (NULL != ConsFileStream.pFile)
+    {
+        FsClose(ConsFileStream.pFile);
+        ConsFileStream.pFile = NULL;
+    }
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Packs 1-Wire operation statistics into a response
+ *
+ * \details Count, Errors, TimeTotal (8 bytes) and TimeMax, little endian.
+ *
+ * \param   pData    - pointer to the response data
+ * \param   pOpStats - pointer to the operation statistics
+ *
+ * \return  uint16_t - Number of bytes packed
+ * ========================================================================== */
+static uint16_t OneWireOpStatsPack(uint8_t *pData, ONEWIRE_OP_STATS *pOpStats)
+{
+    uint16_t Count;         /* Bytes packed */
+
+    Count = 0;
+    memcpy(&pData[Count], &pOpStats->Count, sizeof(uint32_t));
+    Count += sizeof(uint32_t);
+    memcpy(&pData[Count], &pOpStats->Errors, sizeof(uint32_t));
+    Count += sizeof(uint32_t);
+    memcpy(&pData[Count], &pOpStats->TimeTotal, sizeof(uint64_t));
+    Count += sizeof(uint64_t);
+    memcpy(&pData[Count], &pOpStats->TimeMax, sizeof(uint32_t));
+    Count += sizeof(uint32_t);
+
+    return Count;
+}
+
 /******************************************************************************/
 /*                             Global Function(s)                             */
 /******************************************************************************/
+
+/* ========================================================================== */
+/**
+ * \brief   Closes the streamed file if the download was abandoned
+ *
+ * \details The file held open by SERIALCMD_GET_OPEN_FILE_DATA is closed when
+ *          no request has come for FILE_STREAM_IDLE_TIMEOUT, so that a host
+ *          stopping part way does not keep the file open. To be called by
+ *          the console manager task whenever it waits for an event.
+ *
+ * \param   < None >
+ *
+ * \return  uint32_t - Time to wait before calling again (mS), 0 if no file is open
+ * ========================================================================== */
+uint32_t FileStreamIdleCheck(void)
+{
+    uint32_t Idle;      /* Time since the last request */
+    uint32_t Wait;      /* Time left before the file is closed */
+
+    Wait = 0;
+
+    if (NULL != ConsFileStream.pFile)
+    {
+        Idle = SigTime() - ConsFileStream.LastAccess;
+        if (Idle >= FILE_STREAM_IDLE_TIMEOUT)
+        {
+            Log(DBG, "Streamed file closed after %d mS idle", Idle);
+            FileStreamClose();
+        }
+        else
+        {
+            Wait = FILE_STREAM_IDLE_TIMEOUT - Idle;
+        }
+    }
+
+    return Wait;
+}
+
 /* ========================================================================== */
 /**
  * \brief   Send Staus variables periodically
@@ -175,6 +175,7 @@ extern void SetUSBPortMode(bool Value);
 extern bool GetUSBPortMode(void);
 extern void ClearPasswordReceived(void);
 extern void FormatDeviceAddr(uint8_t *InputId, uint8_t *OutputId);
+extern uint32_t FileStreamIdleCheck(void);
 /**
  * \}
  */
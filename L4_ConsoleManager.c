@@ -56,6 +56,7 @@ OS_STK    ConsoleMgrTaskStack[CONSOLE_MGR_TASK_STACK + MEMORY_FENCE_SIZE_DWORDS]
 static CONS_MGR_STATE ConsEventState = CONS_MGR_STATE_WAIT_FOR_EVENT;
 static bool ConsoleMgrInitDone = false;         /* to avoid multiple init */
 static OS_EVENT *pSemaConsole;
+static CONS_MGR_STATS ConsStats;                /* Command processing statistics */
 /// \todo 03/22/2022 KA: uncommenting the pragma below creates a compiler warning, why?
 //#pragma location=".sram"
 PARTIALDATA PartData;
@@ -68,6 +69,7 @@ static CONS_MGR_STATE ReadCommMgrBuffer(void);
 static uint16_t Get16BitValue(uint8_t *pData);
 static CONS_MGR_STATUS SendResponse(PROCESSDATA *pData);
 static CONS_MGR_STATE ValidateCommand(PROCESSDATA *pDataFrame);
+static void UpdateStats(PROCESSDATA *pData, uint32_t StartCycles);
 
 /******************************************************************************/
 /*                                 Local Functions                            */
@@ -85,16 +87,23 @@ static CONS_MGR_STATE ValidateCommand(PROCESSDATA *pDataFrame);
  * ========================================================================== */
 static void ConsoleMgrTask(void *pArg)
 {
-    uint8_t Error = false;
+    uint8_t  Error = false;
+    uint32_t StartCycles;           /* Cycle count at the start of the command */
 
     static CONS_MGR_STATE ConsoleProcState = CONS_MGR_STATE_WAIT_FOR_EVENT;
 
+    StartCycles = 0;
+
     while ( true )
     {
         switch ( ConsoleProcState )
         {
             case CONS_MGR_STATE_WAIT_FOR_EVENT:
-                OSSemPend(pSemaConsole, 0, &Error); /* pend for an event by default */
+                OSSemPend(pSemaConsole, FileStreamIdleCheck(), &Error); /* pend for an event, wake to release an abandoned file download */
+                if ( OS_ERR_TIMEOUT == Error )
+                {
+                    break;  /* no event, check the streamed file again */
+                }
                 if ( OS_ERR_NONE != Error )
                 {
                     Log(ERR, "ConsoleMgrTask: OSSemPend time out error");
@@ -113,11 +122,13 @@ static void ConsoleMgrTask(void *pArg)
                 break;
 
             case CONS_MGR_STATE_PROCESS_COMMAND:
+                StartCycles = CPU_COUNTER_READ_CYCLES();
                 ConsoleProcState = ProcessCommand( &DataProcess );
                 break;
 
             case CONS_MGR_STATE_SEND_RESPONSE:
                 SendResponse( &DataProcess );
+                UpdateStats( &DataProcess, StartCycles );
                 /* if we have more commands to process go back to ProcessCommand State */
                 if ( DataProcess.ValidCommandCount > 0 )
                 {
@@ -459,6 +470,43 @@ static CONS_MGR_STATUS SendResponse(PROCESSDATA *pSendData)
     return Status;
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Update command statistics
+ *
+ * \details Adds the command just responded to the statistics, if it is the
+ *          command being measured.
+ *
+ * \param   pData - pointer to the processed data
+ * \param   StartCycles - CPU cycle count when command processing started
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void UpdateStats(PROCESSDATA *pData, uint32_t StartCycles)
+{
+    uint32_t ProcessTime;       /* Time to process and respond (uS) */
+    uint8_t  Command;           /* Command responded to */
+
+    Command = pData->pValidCommands[pData->CommandCounter][pData->PacketStartIndex[pData->CommandCounter] + COMMAND_OFFSET_16BIT];
+
+    /* The setup command that restarted the statistics is not part of them */
+    if ((SERIALCMD_COMM_TEST_SETUP != Command) &&
+        ((SERIALCMD_UNKNOWN == ConsStats.Command) || (Command == ConsStats.Command)))
+    {
+        ProcessTime = CPU_CYCLES_TO_USEC(CPU_COUNTER_READ_CYCLES() - StartCycles);
+
+        ConsStats.CommandCount++;
+        ConsStats.RxBytes += pData->DataSize;
+        ConsStats.TxBytes += pData->TxDataCount;
+        ConsStats.ProcessTimeTotal += ProcessTime;
+        if (ProcessTime > ConsStats.ProcessTimeMax)
+        {
+            ConsStats.ProcessTimeMax = ProcessTime;
+        }
+    }
+}
+
 /* ========================================================================== */
 /**
  * \brief   helper function
@@ -539,6 +587,9 @@ CONS_MGR_STATUS L4_ConsoleMgrInit(void)
             Log(ERR, "L4_ConsoleManagerInit: No active connection");
         }
 
+        /* Measure all commands until a client selects one */
+        L4_ConsoleMgrStatsStart(SERIALCMD_UNKNOWN);
+
         /* Initialization done */
         ConsoleMgrInitDone = true;
         /// \todo 06/01/2021 CPK Below task creation to be Integrated to streaming task - disabled with compiler switch
@@ -609,6 +660,48 @@ bool L4_ConsoleMgrUpdateInterface(COMM_IF *pActiveInterface)
     return false;
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Function to get the command statistics
+ *
+ * \details Gets the command processing statistics gathered since the last
+ *          L4_ConsoleMgrStatsStart.
+ *
+ * \note    Statistics are updated by the console manager task. Call from
+ *          command processing only.
+ *
+ * \param   pStats - pointer to return the statistics
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L4_ConsoleMgrStatsGet(CONS_MGR_STATS *pStats)
+{
+    if (NULL != pStats)
+    {
+        *pStats = ConsStats;
+    }
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Function to restart the command statistics
+ *
+ * \details Clears the command processing statistics and selects the command
+ *          to measure.
+ *
+ * \param   Cmd - command to measure. SERIALCMD_UNKNOWN to measure all commands.
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L4_ConsoleMgrStatsStart(SERIAL_CMD Cmd)
+{
+    memset(&ConsStats, 0, sizeof(ConsStats));
+    ConsStats.Command = (uint8_t)Cmd;
+    ConsStats.StartTime = SigTime();
+}
+
 /* ========================================================================== */
 /**
  * \brief   Function to send data
@@ -70,6 +70,19 @@ typedef struct
     uint16_t    RemainingDataSize;
 } PARTIALDATA;
 
+/// Command processing statistics. Gathered for one command, or all commands, between
+/// SERIALCMD_COMM_TEST_SETUP requests, so a PC client can measure protocol performance.
+typedef struct
+{
+    uint8_t     Command;            ///< Command measured. SERIALCMD_UNKNOWN for all commands.
+    uint32_t    CommandCount;       ///< Commands processed
+    uint32_t    RxBytes;            ///< Command payload bytes received
+    uint32_t    TxBytes;            ///< Response payload bytes sent
+    uint32_t    ProcessTimeTotal;   ///< Total time to process and respond (uS)
+    uint32_t    ProcessTimeMax;     ///< Longest time to process and respond (uS)
+    uint32_t    StartTime;          ///< Time statistics were started (mS)
+} CONS_MGR_STATS;
+
 typedef void ( *CONS_CMD_HANDLER ) ( void *pPayload, uint8_t  PayloadSize ); /*! Event handler function */
 
 /******************************************************************************/
@@ -83,6 +96,8 @@ extern void SendStatusVars(void *pArg);
 extern bool L4_ConsoleMgrInitDone(void);
 extern void CommEventHandler(COMM_MGR_EVENT Event);
 extern bool L4_ConsoleMgrUpdateInterface(COMM_IF *pActiveInterface);
+extern void L4_ConsoleMgrStatsGet(CONS_MGR_STATS *pStats);
+extern void L4_ConsoleMgrStatsStart(SERIAL_CMD Cmd);
 
 /**
  * \}
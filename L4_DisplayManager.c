@@ -56,6 +56,9 @@ static bool sb_PlaySequenceOnlyOnce = false;
 #define DM_YIELD_WHEN_DEAD      (1000u)              /*! Delay used to yield during critical errors */
 #define DM_BACKGROUND_COLOR     (SIG_COLOR_BLACK)    /*! Default background color used when screen cleared */
 #define SCREEN_REFRESH_TIME     (MSEC_300)           /*! Screen refresh time period */
+#define DM_OBJECT_MAX           (24u)                /*! Objects per screen tracked for changes. Larger screens are redrawn in full */
+#define DM_DIRTY_RECT_MAX       (4u)                 /*! Separate areas redrawn per frame. More are merged */
+#define DM_DISPLAY_PIXELS       (96u * 96u)          /*! Pixels on the display */
 
 /******************************************************************************/
 /*                             Global Variable Definitions(s)                 */
@@ -83,6 +86,21 @@ typedef struct
     SCREEN_LOCK ScreenLock;
 } SCREENINF_NEW;
 
+typedef struct
+{
+    UI_OBJECT *pObject;                         /*! Object drawn */
+    UI_OBJECT Drawn;                            /*! Object contents when drawn */
+    DISP_RECT Rect;                             /*! Area drawn */
+} DM_DRAWN_OBJECT;
+
+typedef struct
+{
+    DM_DRAWN_OBJECT Object[DM_OBJECT_MAX];      /*! Objects drawn by the last frame, in drawing order */
+    uint8_t ObjectCount;                        /*! Number of objects drawn by the last frame */
+    bool Valid;                                 /*! Object list matches the display. If false the next frame is redrawn in full */
+    uint32_t CopyCount;                         /*! Full display copy count after the last frame */
+} DM_FRAME;
+
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
 /******************************************************************************/
@@ -96,6 +114,8 @@ static OS_EVENT *pSemDisplayUpdate;               /*! Semaphore to pend */
 static SCREENINF_NEW ScreenInfo_New;                      /*! Screen details */
 //static DM_SCREEN *pSavedScreen;                   /*! Screen pointer to the saved screen */
 bool g_bUseNewUIThreadFunction = false;
+static DM_FRAME LastFrame;                        /*! Objects on the display */
+static DM_FRAME_STATS FrameStats;                 /*! Display update statistics */
 /******************************************************************************/
 /*                             Local Function Prototype(s)                    */
 /******************************************************************************/
@@ -103,6 +123,10 @@ static void DmTask(void *pArg);
 //static DM_STATUS DmUpdateDisplay(DM_SCREEN *pScreen, bool ForceRefresh, bool CopyToLCD);
 //static DM_STATUS DmClipRefresh(DM_SCREEN *pScreen);
 static DM_STATUS DmUpdateDisplay_New(UI_SEQUENCE *pSequence);
+static void DmObjectDraw(UI_OBJECT *pObject);
+static bool DmRectOverlap(const DISP_RECT *pRectA, const DISP_RECT *pRectB);
+static uint32_t DmRectArea(const DISP_RECT *pRect);
+static void DmDirtyRectAdd(DISP_RECT *pDirtyRect, uint8_t *pDirtyCount, const DISP_RECT *pRect);
 //static DM_STATUS L4_DmRefreshScreen_New(void);
 static void ScreenInfoInit(void);
 /******************************************************************************/
@@ -118,7 +142,9 @@ void ScreenInfoInit(void)
 /**
  * \brief   Display Manager task
  *
- * \details The task waits on the semaphore to refresh the screen.
+ * \details The task refreshes the screen every refresh period, and runs the
+ *          widget server for the clips in between. It sleeps until the next
+ *          screen refresh or clip image change, whichever is earlier.
  *
  * \param   pArg - Task arguments
  *
@@ -128,27 +154,55 @@ void ScreenInfoInit(void)
 static void DmTask(void *pArg)
 {
   uint8_t OsError;
+  uint32_t NextRefresh;               /* Time (mS) of the next screen refresh */
+  uint32_t Now;
+  uint32_t Wait;
+  uint32_t ClipWait;                  /* Time (mS) to the next clip image change */
   
   ScreenInfoInit();
   
+  NextRefresh = SigTime() + ScreenInfo_New.RefreshRate;
+  Wait = ScreenInfo_New.RefreshRate;
+  
   while (true)
   {
     
      // Give other threads / tasks a chance:
-      OSTimeDly(ScreenInfo_New.RefreshRate);
-           
-      if(NULL != ScreenInfo_New.pActiveScreen)
+      OSTimeDly(Wait);
+      
+      OSMutexPend(pMutexDispManager, OS_WAIT_FOREVER, &OsError);
+      if(OS_ERR_NONE != OsError)
       {
-        OSMutexPend(pMutexDispManager, OS_WAIT_FOREVER, &OsError);
-        if(OS_ERR_NONE != OsError)
+          Log(ERR, "DmTask: OSMutexPend error");
+          /* \todo MISSING <01/15/2020> <KJ> <Add exception handler here> */
+          break;
+      }
+      
+      Now = SigTime();
+      if ((int32_t)(Now - NextRefresh) >= 0)
+      {
+        // Refresh periods follow on from each other; resync if a whole period was missed
+        NextRefresh += ScreenInfo_New.RefreshRate;
+        if ((int32_t)(Now - NextRefresh) >= 0)
         {
-            Log(ERR, "DmTask: OSMutexPend error");
-            /* \todo MISSING <01/15/2020> <KJ> <Add exception handler here> */
-            break;
+          NextRefresh = Now + ScreenInfo_New.RefreshRate;
+        }
+        
+        if(NULL != ScreenInfo_New.pActiveScreen)
+        {
+          DmUpdateDisplay_New(ScreenInfo_New.pActiveScreen);
         }
-        DmUpdateDisplay_New(ScreenInfo_New.pActiveScreen);
-        OSMutexPost(pMutexDispManager);
       }
+      
+      L3_WidgetServerRun();
+      OSMutexPost(pMutexDispManager);
+      
+      // Sleep until the next screen refresh or clip image change, at least a tick
+      Now = SigTime();
+      Wait = ((int32_t)(NextRefresh - Now) > 0) ? (NextRefresh - Now) : 0;
+      ClipWait = L3_WidgetServerNextWait();
+      Wait = (ClipWait < Wait) ? ClipWait : Wait;
+      Wait = (Wait > 0) ? Wait : 1;
     
       sb_UIthreadIsRunning = true; // this flad says our UI task is REALLY started and running
   }
@@ -196,6 +250,14 @@ static DM_STATUS DmUpdateDisplay_New(UI_SEQUENCE *pSequence)
   UI_SCREEN* pCurrentScreen;
   UI_OBJECT* pCurrentUIObject;
   uint8_t uiCurrentObjectIndex;
+  uint8_t ObjectCount;                /* Objects on the current screen */
+  uint8_t MaxCount;                   /* Objects on the current or last screen */
+  DM_DRAWN_OBJECT *pDrawn;            /* Object drawn in the same place last frame */
+  DISP_RECT DirtyRect[DM_DIRTY_RECT_MAX];  /* Areas to redraw */
+  uint8_t DirtyCount;
+  uint8_t DirtyIndex;
+  bool FullRedraw;                    /* Redraw and copy the whole display */
+  uint32_t StartCycles;               /* Cycle count at the start of the frame */
   
   Status = DM_STATUS_ERROR;
   
@@ -226,58 +288,261 @@ static DM_STATUS DmUpdateDisplay_New(UI_SEQUENCE *pSequence)
       }
     }
     
-    uiCurrentObjectIndex = 0;
+    StartCycles = CPU_COUNTER_READ_CYCLES();
     
-    do
+    // Look at all items on the current screen:
+    // First, we execute the function, if there is one, so the objects are up to date:
+    for(uiCurrentObjectIndex = 0; NULL != pCurrentScreen[uiCurrentObjectIndex].OurUIObject; ++uiCurrentObjectIndex)
     {
-      pCurrentUIObject = (&pCurrentScreen[uiCurrentObjectIndex])->OurUIObject;
-      if(NULL == pCurrentUIObject) break;
-      
-      // Look at all items on the current screen:
-      // First, we execute the function, if there is one:
+      pCurrentUIObject = pCurrentScreen[uiCurrentObjectIndex].OurUIObject;
       
       if(NULL != pCurrentUIObject -> pFunction)
         pCurrentUIObject -> pFunction(0);
+    }
+    ObjectCount = uiCurrentObjectIndex;
+    
+    // Redraw in full if the display no longer matches the last frame (another screen was copied to it)
+    // or the screen has too many objects to track:
+    FullRedraw = (!LastFrame.Valid) || (ObjectCount > DM_OBJECT_MAX) || (L3_DispMemDevCopyCount() != LastFrame.CopyCount);
+#ifndef DM_DIRTY_RECT_UPDATE
+    FullRedraw = true;
+#endif
+    if(FullRedraw)
+    {
+      LastFrame.ObjectCount = 0;      // every object is new
+    }
+    
+    // Then, compare each object with the one drawn in its place last frame. A changed object
+    // dirties the area it covered and the area it covers now:
+    DirtyCount = 0;
+    MaxCount = (ObjectCount > LastFrame.ObjectCount) ? ObjectCount : LastFrame.ObjectCount;
+    MaxCount = (MaxCount > DM_OBJECT_MAX) ? DM_OBJECT_MAX : MaxCount;
+    
+    for(uiCurrentObjectIndex = 0; uiCurrentObjectIndex < MaxCount; ++uiCurrentObjectIndex)
+    {
+      pDrawn = &LastFrame.Object[uiCurrentObjectIndex];
       
-      // Then, we see what object is it:
-      switch(pCurrentUIObject->OurObjectType)
+      if(uiCurrentObjectIndex < LastFrame.ObjectCount)
       {
-      case UI_TYPE_TEXT:
-        // draw text
-        L3_WidgetTextDraw_New(&pCurrentUIObject->ObjText);    
-        break;
-        
-      case UI_TYPE_SQUARE:
-        // draw square
-        break;
-        
-      case UI_TYPE_CIRCLE:
-        // draw circle
-        L3_WidgetCircleDraw(&pCurrentUIObject->ObjCircle);
-        break;
-        
-      case UI_TYPE_BITMAP:
-        // draw image
-        L3_WidgetImageDraw_New(&pCurrentUIObject->ObjBitmap);
-        break;
+        if((uiCurrentObjectIndex < ObjectCount) &&
+           (pCurrentScreen[uiCurrentObjectIndex].OurUIObject == pDrawn->pObject) &&
+           (0 == memcmp(pDrawn->pObject, &pDrawn->Drawn, sizeof(UI_OBJECT))))
+        {
+          continue;   // unchanged
+        }
+        DmDirtyRectAdd(DirtyRect, &DirtyCount, &pDrawn->Rect);
+      }
+      
+      if(uiCurrentObjectIndex < ObjectCount)
+      {
+        pDrawn->pObject = pCurrentScreen[uiCurrentObjectIndex].OurUIObject;
+        memcpy(&pDrawn->Drawn, pDrawn->pObject, sizeof(UI_OBJECT));
+        L3_WidgetObjectRect(pDrawn->pObject, &pDrawn->Rect);
+        DmDirtyRectAdd(DirtyRect, &DirtyCount, &pDrawn->Rect);
+      }
+    }
+    
+    FrameStats.PixelCount = 0;
+    
+    if(FullRedraw)
+    {
+      for(uiCurrentObjectIndex = 0; uiCurrentObjectIndex < ObjectCount; ++uiCurrentObjectIndex)
+      {
+        DmObjectDraw(pCurrentScreen[uiCurrentObjectIndex].OurUIObject);
+      }
+      L3_DispMemDevCopyToLCD();
+      
+      FrameStats.PixelCount = DM_DISPLAY_PIXELS;
+      FrameStats.FullFrameCount++;
+    }
+    else
+    {
+      // Redraw, in order, the objects over each changed area - clipped to it, as objects
+      // outside it are not redrawn on top - and copy just that area to the display:
+      for(DirtyIndex = 0; DirtyIndex < DirtyCount; ++DirtyIndex)
+      {
+        L3_DispSetClipRect(&DirtyRect[DirtyIndex]);
+        for(uiCurrentObjectIndex = 0; uiCurrentObjectIndex < ObjectCount; ++uiCurrentObjectIndex)
+        {
+          if(DmRectOverlap(&LastFrame.Object[uiCurrentObjectIndex].Rect, &DirtyRect[DirtyIndex]))
+          {
+            DmObjectDraw(LastFrame.Object[uiCurrentObjectIndex].pObject);
+          }
+        }
+        L3_DispSetClipRect(NULL);
         
-      case UI_TYPE_PROGRESS:
-        // draw progress bar
-        L3_WidgetProgressBarDraw_New(&pCurrentUIObject->ObjProgress);
-        break;
-      } // switch
+        L3_DispMemDevCopyRectToLCD(&DirtyRect[DirtyIndex]);
+        FrameStats.PixelCount += DmRectArea(&DirtyRect[DirtyIndex]);
+      }
       
-      ++uiCurrentObjectIndex;
-    } while(1); // do
+      if(0 == DirtyCount)
+      {
+        FrameStats.IdleFrameCount++;
+      }
+    }
+    
+    LastFrame.ObjectCount = (ObjectCount > DM_OBJECT_MAX) ? 0 : ObjectCount;
+    LastFrame.Valid = (ObjectCount <= DM_OBJECT_MAX);
+    LastFrame.CopyCount = L3_DispMemDevCopyCount();
+    
+    FrameStats.FrameCount++;
+    FrameStats.PixelTotal += FrameStats.PixelCount;
+    FrameStats.FrameTime = CPU_CYCLES_TO_USEC(CPU_COUNTER_READ_CYCLES() - StartCycles);
+    if(FrameStats.FrameTime > FrameStats.FrameTimeMax)
+    {
+      FrameStats.FrameTimeMax = FrameStats.FrameTime;
+    }
     
     Status = DM_STATUS_OK;
     
-    L3_DispMemDevCopyToLCD();
     ++GlobalCurrentSequenceIndex; // go to the next screen in the sequence
   } while (false);
   
   return Status;
 }
+//##############################################################################################################
+/* ========================================================================== */
+/**
+ * \brief   Draw a UI object
+ *
+ * \details Draws the object with the widget function for its type
+ *
+ * \param   pObject - pointer to the UI object
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void DmObjectDraw(UI_OBJECT *pObject)
+{
+  switch(pObject->OurObjectType)
+  {
+  case UI_TYPE_TEXT:
+    // draw text
+    L3_WidgetTextDraw_New(&pObject->ObjText);    
+    break;
+    
+  case UI_TYPE_SQUARE:
+    // draw square
+    break;
+    
+  case UI_TYPE_CIRCLE:
+    // draw circle
+    L3_WidgetCircleDraw(&pObject->ObjCircle);
+    break;
+    
+  case UI_TYPE_BITMAP:
+    // draw image
+    L3_WidgetImageDraw_New(&pObject->ObjBitmap);
+    break;
+    
+  case UI_TYPE_PROGRESS:
+    // draw progress bar
+    L3_WidgetProgressBarDraw_New(&pObject->ObjProgress);
+    break;
+  } // switch
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Check if two rectangles overlap
+ *
+ * \param   pRectA - first rectangle (inclusive coordinates)
+ * \param   pRectB - second rectangle (inclusive coordinates)
+ *
+ * \return  bool - true if the rectangles share a pixel. Empty rectangles overlap nothing.
+ *
+ * ========================================================================== */
+static bool DmRectOverlap(const DISP_RECT *pRectA, const DISP_RECT *pRectB)
+{
+  return ((pRectA->x0 <= pRectA->x1) && (pRectA->y0 <= pRectA->y1) &&
+          (pRectB->x0 <= pRectB->x1) && (pRectB->y0 <= pRectB->y1) &&
+          (pRectA->x0 <= pRectB->x1) && (pRectB->x0 <= pRectA->x1) &&
+          (pRectA->y0 <= pRectB->y1) && (pRectB->y0 <= pRectA->y1));
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Get the pixel count of a rectangle
+ *
+ * \param   pRect - rectangle (inclusive coordinates)
+ *
+ * \return  uint32_t - Number of pixels. 0 if the rectangle is empty.
+ *
+ * ========================================================================== */
+static uint32_t DmRectArea(const DISP_RECT *pRect)
+{
+  uint32_t Area;
+  
+  Area = 0;
+  if((pRect->x0 <= pRect->x1) && (pRect->y0 <= pRect->y1))
+  {
+    Area = (uint32_t)(pRect->x1 - pRect->x0 + 1) * (uint32_t)(pRect->y1 - pRect->y0 + 1);
+  }
+  return Area;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Add an area to the dirty rectangle list
+ *
+ * \details An area overlapping a listed rectangle is merged into it. When the
+ *          list is full, the area is merged into the rectangle that grows least.
+ *
+ * \param   pDirtyRect - dirty rectangle list (DM_DIRTY_RECT_MAX entries)
+ * \param   pDirtyCount - pointer to number of rectangles in the list
+ * \param   pRect - area to add (inclusive coordinates)
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void DmDirtyRectAdd(DISP_RECT *pDirtyRect, uint8_t *pDirtyCount, const DISP_RECT *pRect)
+{
+  uint8_t Index;
+  uint8_t MergeIndex;
+  uint32_t Growth;
+  uint32_t MinGrowth;
+  DISP_RECT Merged;
+  
+  do
+  {
+    BREAK_IF(0 == DmRectArea(pRect));
+    
+    // Merge with an overlapping rectangle, else with the one that grows least if the list is full:
+    MergeIndex = *pDirtyCount;
+    MinGrowth = UINT32_MAX_VALUE;
+    for(Index = 0; Index < *pDirtyCount; ++Index)
+    {
+      Merged.x0 = (pRect->x0 < pDirtyRect[Index].x0) ? pRect->x0 : pDirtyRect[Index].x0;
+      Merged.y0 = (pRect->y0 < pDirtyRect[Index].y0) ? pRect->y0 : pDirtyRect[Index].y0;
+      Merged.x1 = (pRect->x1 > pDirtyRect[Index].x1) ? pRect->x1 : pDirtyRect[Index].x1;
+      Merged.y1 = (pRect->y1 > pDirtyRect[Index].y1) ? pRect->y1 : pDirtyRect[Index].y1;
+      Growth = DmRectArea(&Merged) - DmRectArea(&pDirtyRect[Index]);
+      
+      if(DmRectOverlap(pRect, &pDirtyRect[Index]))
+      {
+        MergeIndex = Index;
+        break;
+      }
+      if((*pDirtyCount >= DM_DIRTY_RECT_MAX) && (Growth < MinGrowth))
+      {
+        MinGrowth = Growth;
+        MergeIndex = Index;
+      }
+    }
+    
+    if(MergeIndex < *pDirtyCount)
+    {
+      pDirtyRect[MergeIndex].x0 = (pRect->x0 < pDirtyRect[MergeIndex].x0) ? pRect->x0 : pDirtyRect[MergeIndex].x0;
+      pDirtyRect[MergeIndex].y0 = (pRect->y0 < pDirtyRect[MergeIndex].y0) ? pRect->y0 : pDirtyRect[MergeIndex].y0;
+      pDirtyRect[MergeIndex].x1 = (pRect->x1 > pDirtyRect[MergeIndex].x1) ? pRect->x1 : pDirtyRect[MergeIndex].x1;
+      pDirtyRect[MergeIndex].y1 = (pRect->y1 > pDirtyRect[MergeIndex].y1) ? pRect->y1 : pDirtyRect[MergeIndex].y1;
+      break;
+    }
+    
+    pDirtyRect[*pDirtyCount] = *pRect;
+    (*pDirtyCount)++;
+  } while (false);
+}
 //##############################################################################################################
  /* ========================================================================== */
 /**
@@ -708,6 +973,30 @@ void L4_DmFillRectangle(uint8_t X1, uint8_t Y1, uint8_t X2, uint8_t Y2)
     L3_DispFillRect(X1, Y1, X2, Y2);
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Function to get the display update statistics
+ *
+ * \details This function gets the per frame pixel and time counters, for
+ *          profiling the display updates.
+ *
+ * \param   pStats - pointer to return the statistics
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L4_DmGetFrameStats(DM_FRAME_STATS *pStats)
+{
+    uint8_t OsError;
+
+    if ((NULL != pStats) && (NULL != pMutexDispManager))
+    {
+        OSMutexPend(pMutexDispManager, OS_WAIT_FOREVER, &OsError);
+        *pStats = FrameStats;
+        OSMutexPost(pMutexDispManager);
+    }
+}
+
 
 /**
  * \}
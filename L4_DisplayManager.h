@@ -43,6 +43,10 @@ extern "C"
 #define BAT_IMAGE_Y_POS   (3u)
 #define BAT_IMAGE_H_VAL   (48u)
 #define BAT_IMAGE_W_VAL   (16u)
+
+/* With DM_DIRTY_RECT_UPDATE defined, each frame redraws and copies to the display only the
+   areas of objects that changed since the last frame. Otherwise every frame is redrawn in full. */
+#define DM_DIRTY_RECT_UPDATE
 /******************************************************************************/
 /*                             Global Type(s)                                 */
 /******************************************************************************/
@@ -117,6 +121,17 @@ typedef struct                          /*! Screen definition, essentially a col
     DM_SCREEN_FUNCTION pWindup;         /*! Function hook called after unloading(switching) screen  */
 } DM_SCREEN;
 
+typedef struct                          /*! Display update statistics, for profiling */
+{
+    uint32_t FrameCount;                /*! Frames processed */
+    uint32_t FullFrameCount;            /*! Frames redrawn and copied to the display in full */
+    uint32_t IdleFrameCount;            /*! Frames with nothing to redraw */
+    uint32_t PixelCount;                /*! Pixels copied to the display by the last frame */
+    uint32_t PixelTotal;                /*! Pixels copied to the display by all frames */
+    uint32_t FrameTime;                 /*! Time taken by the last frame (uS) */
+    uint32_t FrameTimeMax;              /*! Longest frame time (uS) */
+} DM_FRAME_STATS;
+
 typedef struct                           /*! Temp Screen attributes*/
 {
    uint16_t  Periodinmsec;               /*! Time period * DM_REFRESH_TICKS for recursive call to the pPEriodic hook function.*/
@@ -141,6 +156,7 @@ extern DM_STATUS L4_DmScreenLockUnLock_New(UI_SEQUENCE *pSequence, SCREEN_LOCK S
 DM_STATUS L4_DmCurrentScreenLockUnLock_New(SCREEN_LOCK ScreenLock);
 //extern DM_STATUS L4_DmProgressBarUpdateColors(uint8_t ProgressBarId, SIG_COLOR_PALETTE BackColor, SIG_COLOR_PALETTE ForeColor);
 extern uint8_t GetScreenID(void);
+extern void L4_DmGetFrameStats(DM_FRAME_STATS *pStats);
 //extern DM_STATUS L4_DmImageUpdate(uint8_t ImageId, BITMAP *pNewImage);
 /**
  * \}
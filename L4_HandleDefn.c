@@ -127,8 +127,7 @@ static AM_STATUS HandleEepRead(void)
         pData = (uint8_t*)&HandleInterface.Data;
 
      /*Perform a pagewire read operation to read entier 64Byte data*/
-        OwEepStatus  = L3_OneWireEepromRead(HandleAddress, OW_EEPROM_PAGE0, pData);
-        OwEepStatus |= L3_OneWireEepromRead(HandleAddress, OW_EEPROM_PAGE1, pData + OW_EEPROM_MEMORY_PAGE_SIZE);
+        OwEepStatus = L3_OneWireEepromReadPages(HandleAddress, OW_EEPROM_PAGE0, OW_EEPROM_NUM_PAGES, pData);
 
         if (OW_EEP_STATUS_OK != OwEepStatus)
         {
@@ -488,8 +487,7 @@ void HandleProcedureFireCountTest(void)
     
     do
     {
-        OneWireEepStatus = L3_OneWireEepromRead(HandleAddress, OW_EEPROM_PAGE_NUM, ReadData);
-        OneWireEepStatus = L3_OneWireEepromRead(HandleAddress, OW_EEPROM_PAGE_NUM2, &ReadData[OW_EEPROM_PAGE_OFFSET]);
+        OneWireEepStatus = L3_OneWireEepromReadCached(HandleAddress, OW_EEPROM_PAGE_NUM, OW_EEPROM_NUM_PAGES, ReadData);
 
         if (OW_EEP_STATUS_OK != OneWireEepStatus)
         {
@@ -109,8 +109,7 @@ static AM_STATUS ReloadEepRead(void)
     Status = AM_STATUS_OK;
     pData = (uint8_t*)&ReloadInterface.Data;
 
-    OwEepStatus  = L3_OneWireEepromRead(ReloadAddress, 0, pData);
-    OwEepStatus |= L3_OneWireEepromRead(ReloadAddress, 1, pData + OW_EEPROM_MEMORY_PAGE_SIZE);
+    OwEepStatus = L3_OneWireEepromReadPages(ReloadAddress, 0, 2, pData);
 
     do
     {
@@ -57,6 +57,7 @@ extern "C"
 #include "L3_Battery.h"
 #include "Version.h"
 #include "TestManager.h"
+#include "FileTypes.h"
 
 /******************************************************************************/
 /*                             Global Constant Definitions(s)                 */
@@ -91,6 +92,12 @@ extern "C"
 #define MAX_RDF_FILE_LIMIT      (0xFFFFu)            ///< Max RDF File number Limit
 
 #define MAX_SUBDIR_PER_MAINDIR  (50u)                ///< Max Subdirectories within a main dir
+#define RDF_INDEX_NAME          ("rdfindex.bin")     ///< RDF retention index, in the "data" dir
+#define RDF_INDEX_VERSION       (1u)                 ///< RDF retention index layout version
+#define RDF_CLEANUP_DELAY       (MSEC_50)            ///< Delay between RDF file deletions - allow time for other tasks
+
+/// L1 directory index of the L2 data directory number Dir. [e.g.: 000052 is in data_000051]
+#define RDF_DIR_LEVEL_ONE(Dir)  (((((Dir) - 1u) / MAX_SUBDIR_PER_MAINDIR) * MAX_SUBDIR_PER_MAINDIR) + 1u)
 #define SDCARD_ROOT_DIR         ("sdcard:0:")        ///< SD Card Root Dir
 #define SDCARD_ROOT_DIR_LENGTH  (9u)                 ///< number of characters in SDCARD_ROOT_DIR
 #define DATA_DIR                ("data")             ///< Data Level 1 Dir name
@@ -106,6 +113,7 @@ extern "C"
 
 /* Note - LOG_FILE_PATH_NAME_LEN not set to maximum, set to minimum length to reduce stack overhead.*/
 #define LOG_FILE_PATH_NAME_LEN         	(8u)                    ///< Log file path name length.
+#define LOG_FORMAT_SPEC_LEN             (16u)                   ///< Max length of a single format conversion specification
 #undef  ENABLE_RDF_DEL                  			///< Debug purpose only - Remove for production
 
 /******************************************************************************/
@@ -116,6 +124,32 @@ OS_STK      LoggerStack[LOGGER_STACK_SIZE + MEMORY_FENCE_SIZE_DWORDS];         /
 /******************************************************************************/
 /*                    Local Type Definition(s)  / Function Prototypes         */
 /******************************************************************************/
+/// RDF retention index. Kept in RAM and mirrored to RDF_INDEX_NAME so the
+/// oldest RDF files can be found without probing the whole directory tree.
+typedef struct
+{
+    uint16_t FileTypeId;        ///< FILE_TYPE_ID_RDF_INDEX
+    uint16_t Version;           ///< RDF_INDEX_VERSION
+    uint16_t OldestDir;         ///< Oldest L2 data directory number holding RDF files
+    uint16_t OldestFile;        ///< Oldest RDF file number in OldestDir
+    uint16_t NewestDir;         ///< Newest (active) L2 data directory number
+    uint16_t Reserved;          ///< Padding
+    uint32_t Crc;               ///< CRC32 of the fields above
+} RDF_INDEX;
+
+/// Argument type consumed by a format conversion specification (deferred logging)
+typedef enum
+{
+    LOG_ARG_NONE,           ///< No argument ("%%")
+    LOG_ARG_INT,            ///< int (also char/short - promoted)
+    LOG_ARG_LONG,           ///< long, size_t, ptrdiff_t
+    LOG_ARG_LONG_LONG,      ///< long long, intmax_t
+    LOG_ARG_DOUBLE,         ///< double (float - promoted)
+    LOG_ARG_STRING,         ///< NUL terminated string - copied into the record
+    LOG_ARG_POINTER,        ///< Pointer
+    LOG_ARG_UNSUPPORTED     ///< Unsupported conversion ('*' width/precision, unknown)
+} LOG_ARG_TYPE;
+
 /* ask QM to declare the Logger class --------------------------------------*/
 
 /*.$declare${AOs::Logger} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
@@ -158,8 +192,19 @@ static void DebugUartSend(uint8_t *pu8DataToSend, uint16_t u16BytesCount);
 static void SendMessageToLog(Logger * const me, LOG_FILE eLogFile, uint8_t *pu8String, uint16_t StringLenIn);
 static bool RotateEventLog(Logger * const me);
 static bool CreateSDCardDataDirectories(Logger * const me);
-static bool SearchOldRdfFiles(FS_FILE_SIZE CleanupSize);
-static bool DeleteOldRdfFiles(FS_FILE_SIZE CleanupSize, uint16_t u16IdxLevelOne, uint16_t u16IdxLevelTwo);
+static bool DeleteOldRdfFiles(FS_FILE_SIZE CleanupSize);
+static bool RdfDirExists(uint16_t u16IdxLevelOne, uint16_t u16Dir);
+static void RdfIndexRebuild(void);
+static void RdfIndexLoad(void);
+static void RdfIndexSave(void);
+static void RdfIndexNewDir(uint16_t u16Dir);
+static void LogProcessMsgSignal(Logger * const me, LOG_FILE eLogFile, QEvt const * const e);
+#ifdef LOG_DEFERRED_FORMAT
+static const char *LogParseFormatSpec(const char *pSpec, LOG_ARG_TYPE *pArgType);
+static bool LogRecordPut(QEVENT_LOG_RECORD *pRecord, const void *pData, uint8_t Size);
+static void LogCaptureArgs(QEVENT_LOG_RECORD *pRecord, va_list xArguments);
+static uint16_t LogRenderRecord(QEVENT_LOG_RECORD const *pRecord, char *pOut, uint16_t OutSize);
+#endif
 
 /******************************************************************************/
 /*                             Local Constant Definition(s)                   */
@@ -193,6 +238,14 @@ static int8_t  pDirPath[FS_CFG_MAX_PATH_NAME_LEN]; /* Eventlog Dir Path */
 static char    pFilePath[LOG_FILE_PATH_NAME_LEN]; /* Eventlog Full File Path */
 static int8_t  sHandleSerialNumber[HANDLE_SERIAL_NUMBER_LEN_MAX];
 static char    DateStr[DATE_STR_LENGTH];
+
+static OS_EVENT *pRdfIndexMutex;                         /* RDF index mutex - Logger & cleanup task */
+static RDF_INDEX RdfIndex;                               /* RDF retention index */
+static bool      RdfIndexLoaded = false;                 /* True once RdfIndex is valid */
+static int8_t    RdfIndexPath[FS_CFG_MAX_PATH_NAME_LEN]; /* RDF index path scratch - guarded by pRdfIndexMutex */
+#ifdef LOG_DEFERRED_FORMAT
+static char    LogRenderBuf[MAX_LOG_STRING_LEN];  /* Deferred Log record render buffer - Logger AO context only */
+#endif
 /******************************************************************************/
 /*                             Local Function(s)                              */
 /******************************************************************************/
@@ -308,6 +361,383 @@ static void SendMessageToLog(Logger * const me, LOG_FILE eLogFile, uint8_t *pu8S
     } while (false);
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Processes a Log message signal.
+ *
+ * \details Renders the Log message (deferred format) if required and sends
+ *          it to the Debug Terminals / Consoles and Filesystem.
+ *
+ * \param   me       - Pointer to local data store
+ * \param   eLogFile - Log file the message is to be logged to
+ * \param   e        - Pointer to the Log message event
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void LogProcessMsgSignal(Logger * const me, LOG_FILE eLogFile, QEvt const * const e)
+{
+#ifdef LOG_DEFERRED_FORMAT
+    uint16_t StringLen;     /* Rendered string length */
+
+    StringLen = LogRenderRecord((QEVENT_LOG_RECORD const *)e, LogRenderBuf, sizeof(LogRenderBuf));
+    SendMessageToLog(me, eLogFile, (uint8_t *)LogRenderBuf, StringLen);
+#else
+    QEVENT_LOG_MSG *pLog;
+
+    pLog = (QEVENT_LOG_MSG *)e;
+    SendMessageToLog(me, eLogFile, pLog->Msg, strlen((char *)pLog->Msg));
+#endif
+}
+
+#ifdef LOG_DEFERRED_FORMAT
+/* ========================================================================== */
+/**
+ * \brief   Parses a format conversion specification.
+ *
+ * \details Skips the flags, width, precision and length modifier of a printf
+ *          conversion specification and classifies the argument it consumes.
+ *          The same parser is used when capturing and when rendering a record,
+ *          so both walk the argument data identically.
+ *
+ * \param   pSpec    - Pointer to the character following the '%'
+ * \param   pArgType - Argument type consumed by the conversion
+ *
+ * \return  Pointer to the character following the conversion specifier
+ *
+ * ========================================================================== */
+static const char *LogParseFormatSpec(const char *pSpec, LOG_ARG_TYPE *pArgType)
+{
+    uint8_t LongCount;      /* Number of 'l' length modifiers */
+    bool    Star;           /* '*' width or precision used */
+
+    LongCount = 0;
+    Star = false;
+
+    /* Flags, width & precision */
+    while ((NUL != *pSpec) && (NULL != strchr("-+ #0123456789.*", *pSpec)))
+    {
+        Star |= ('*' == *pSpec);
+        pSpec++;
+    }
+
+    /* Length modifiers */
+    while ((NUL != *pSpec) && (NULL != strchr("hlLzjt", *pSpec)))
+    {
+        if ('l' == *pSpec)
+        {
+            LongCount++;
+        }
+        else if ('j' == *pSpec)
+        {
+            LongCount = 2;
+        }
+        else if (('z' == *pSpec) || ('t' == *pSpec))
+        {
+            LongCount = MAX(LongCount, 1);
+        }
+        else
+        {
+            /* 'h' & 'L' - no change */
+        }
+        pSpec++;
+    }
+
+    switch (*pSpec)
+    {
+        case '%':
+            *pArgType = LOG_ARG_NONE;
+            break;
+
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            *pArgType = (LongCount > 1) ? LOG_ARG_LONG_LONG : ((LongCount > 0) ? LOG_ARG_LONG : LOG_ARG_INT);
+            break;
+
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            *pArgType = LOG_ARG_DOUBLE;
+            break;
+
+        case 's':
+            *pArgType = LOG_ARG_STRING;
+            break;
+
+        case 'p':
+            *pArgType = LOG_ARG_POINTER;
+            break;
+
+        default:
+            *pArgType = LOG_ARG_UNSUPPORTED;
+            break;
+    }
+
+    if (Star)
+    {
+        *pArgType = LOG_ARG_UNSUPPORTED;
+    }
+
+    if (NUL != *pSpec)
+    {
+        pSpec++;
+    }
+
+    return pSpec;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Appends raw data to a deferred Log record.
+ *
+ * \param   pRecord - Pointer to the Log record
+ * \param   pData   - Data to append
+ * \param   Size    - Number of bytes to append
+ *
+ * \return  bool - true if appended, false if the record is full
+ *
+ * ========================================================================== */
+static bool LogRecordPut(QEVENT_LOG_RECORD *pRecord, const void *pData, uint8_t Size)
+{
+    bool Status;
+
+    Status = false;
+
+    if ((pRecord->DataLen + Size) <= LOG_RECORD_DATA_LEN)
+    {
+        memcpy(&pRecord->Data[pRecord->DataLen], pData, Size);
+        pRecord->DataLen += Size;
+        Status = true;
+    }
+
+    return Status;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Captures the raw Log arguments into a deferred Log record.
+ *
+ * \details Walks the format string and copies each argument's raw words into
+ *          the record. Strings are copied (truncated to the space left) as the
+ *          caller's buffer may not exist by the time the record is rendered.
+ *          Capture stops at the first argument that does not fit or cannot be
+ *          captured; ArgCount holds the number of conversions captured.
+ *
+ * \param   pRecord    - Pointer to the Log record. pFormatString must be set.
+ * \param   xArguments - Variadic arguments
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void LogCaptureArgs(QEVENT_LOG_RECORD *pRecord, va_list xArguments)
+{
+    const char   *pFormat;      /* Format string walker */
+    const char   *pString;      /* String argument */
+    LOG_ARG_TYPE  ArgType;      /* Argument type */
+    bool          Fits;         /* Argument captured */
+    int           IntArg;
+    long          LongArg;
+    long long     LongLongArg;
+    double        DoubleArg;
+    void         *pPtrArg;
+    uint8_t       StringLen;
+
+    pFormat = pRecord->pFormatString;
+    pRecord->ArgCount = 0;
+    pRecord->DataLen = 0;
+    Fits = true;
+
+    while ((NUL != *pFormat) && Fits)
+    {
+        if ('%' != *pFormat++)
+        {
+            continue;
+        }
+
+        pFormat = LogParseFormatSpec(pFormat, &ArgType);
+
+        switch (ArgType)
+        {
+            case LOG_ARG_NONE:
+                break;
+
+            case LOG_ARG_INT:
+                IntArg = va_arg(xArguments, int);
+                Fits = LogRecordPut(pRecord, &IntArg, sizeof(IntArg));
+                break;
+
+            case LOG_ARG_LONG:
+                LongArg = va_arg(xArguments, long);
+                Fits = LogRecordPut(pRecord, &LongArg, sizeof(LongArg));
+                break;
+
+            case LOG_ARG_LONG_LONG:
+                LongLongArg = va_arg(xArguments, long long);
+                Fits = LogRecordPut(pRecord, &LongLongArg, sizeof(LongLongArg));
+                break;
+
+            case LOG_ARG_DOUBLE:
+                DoubleArg = va_arg(xArguments, double);
+                Fits = LogRecordPut(pRecord, &DoubleArg, sizeof(DoubleArg));
+                break;
+
+            case LOG_ARG_POINTER:
+                pPtrArg = va_arg(xArguments, void *);
+                Fits = LogRecordPut(pRecord, &pPtrArg, sizeof(pPtrArg));
+                break;
+
+            case LOG_ARG_STRING:
+                pString = va_arg(xArguments, const char *);
+                if (NULL == pString)
+                {
+                    pString = "(null)";
+                }
+                /* Copy as much of the string as fits, always NUL terminated */
+                Fits = (pRecord->DataLen < LOG_RECORD_DATA_LEN);
+                if (Fits)
+                {
+                    StringLen = (uint8_t)strnlen(pString, (LOG_RECORD_DATA_LEN - pRecord->DataLen) - 1);
+                    memcpy(&pRecord->Data[pRecord->DataLen], pString, StringLen);
+                    pRecord->Data[pRecord->DataLen + StringLen] = NUL;
+                    pRecord->DataLen += StringLen + 1;
+                }
+                break;
+
+            default:
+                Fits = false;
+                break;
+        }
+
+        if (Fits && (LOG_ARG_NONE != ArgType))
+        {
+            pRecord->ArgCount++;
+        }
+    }
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Renders a deferred Log record to text.
+ *
+ * \details Creates the same prefix and message text LogMsg created in the
+ *          caller's context before deferred formatting was introduced:
+ *          "[Level],[Group],[Line],[Count],[Time]: [Message]\r\n". Each
+ *          conversion is formatted individually from the captured raw data.
+ *
+ * \param   pRecord - Pointer to the Log record
+ * \param   pOut    - Output buffer
+ * \param   OutSize - Output buffer size
+ *
+ * \return  uint16_t - Length of the rendered string
+ *
+ * ========================================================================== */
+static uint16_t LogRenderRecord(QEVENT_LOG_RECORD const *pRecord, char *pOut, uint16_t OutSize)
+{
+    const char   *pFormat;                      /* Format string walker */
+    const char   *pSpecStart;                   /* Start of conversion specification */
+    char          Spec[LOG_FORMAT_SPEC_LEN];    /* Single conversion specification */
+    LOG_ARG_TYPE  ArgType;                      /* Argument type */
+    uint16_t      Limit;                        /* Max message length, room left for CR+LF+NUL */
+    uint16_t      Len;                          /* Rendered length */
+    uint16_t      DataIdx;                      /* Read index into record data */
+    uint8_t       ArgsLeft;                     /* Captured arguments not yet rendered */
+    int           Written;                      /* Characters written by a conversion */
+    int           IntArg;
+    long          LongArg;
+    long long     LongLongArg;
+    double        DoubleArg;
+    void         *pPtrArg;
+
+    Limit = OutSize - LEN_CR_LF_NULL;
+
+    /* Create the Prefix string. */
+    Len = Str_FmtPrint((CPU_CHAR *)pOut, OutSize, "%1.1d,%2.2d,%4.4d,%5.5d,%d: ",
+                       pRecord->LogLevel, pRecord->LogGroup, pRecord->LineNumber, pRecord->LogCounter, pRecord->TimeStamp);
+
+    pFormat = pRecord->pFormatString;
+    DataIdx = 0;
+    ArgsLeft = pRecord->ArgCount;
+
+    while ((NUL != *pFormat) && ((Len + 1u) < Limit))
+    {
+        if ('%' != *pFormat)
+        {
+            pOut[Len++] = *pFormat++;
+            continue;
+        }
+
+        pSpecStart = pFormat++;
+        pFormat = LogParseFormatSpec(pFormat, &ArgType);
+
+        if (LOG_ARG_NONE == ArgType)
+        {
+            pOut[Len++] = '%';
+            continue;
+        }
+
+        /* Stop at the first conversion that was not captured, or is too long */
+        if ((0 == ArgsLeft) || ((pFormat - pSpecStart) >= LOG_FORMAT_SPEC_LEN))
+        {
+            break;
+        }
+        memcpy(Spec, pSpecStart, pFormat - pSpecStart);
+        Spec[pFormat - pSpecStart] = NUL;
+        ArgsLeft--;
+
+        switch (ArgType)
+        {
+            case LOG_ARG_INT:
+                memcpy(&IntArg, &pRecord->Data[DataIdx], sizeof(IntArg));
+                DataIdx += sizeof(IntArg);
+                Written = snprintf(&pOut[Len], Limit - Len, Spec, IntArg);
+                break;
+
+            case LOG_ARG_LONG:
+                memcpy(&LongArg, &pRecord->Data[DataIdx], sizeof(LongArg));
+                DataIdx += sizeof(LongArg);
+                Written = snprintf(&pOut[Len], Limit - Len, Spec, LongArg);
+                break;
+
+            case LOG_ARG_LONG_LONG:
+                memcpy(&LongLongArg, &pRecord->Data[DataIdx], sizeof(LongLongArg));
+                DataIdx += sizeof(LongLongArg);
+                Written = snprintf(&pOut[Len], Limit - Len, Spec, LongLongArg);
+                break;
+
+            case LOG_ARG_DOUBLE:
+                memcpy(&DoubleArg, &pRecord->Data[DataIdx], sizeof(DoubleArg));
+                DataIdx += sizeof(DoubleArg);
+                Written = snprintf(&pOut[Len], Limit - Len, Spec, DoubleArg);
+                break;
+
+            case LOG_ARG_POINTER:
+                memcpy(&pPtrArg, &pRecord->Data[DataIdx], sizeof(pPtrArg));
+                DataIdx += sizeof(pPtrArg);
+                Written = snprintf(&pOut[Len], Limit - Len, Spec, pPtrArg);
+                break;
+
+            case LOG_ARG_STRING:
+                Written = snprintf(&pOut[Len], Limit - Len, Spec, (const char *)&pRecord->Data[DataIdx]);
+                DataIdx += strlen((const char *)&pRecord->Data[DataIdx]) + 1;
+                break;
+
+            default:
+                Written = 0;
+                break;
+        }
+
+        if (Written > 0)
+        {
+            Len = MIN(Len + (uint16_t)Written, Limit - 1u);
+        }
+    }
+
+    pOut[Len] = NUL;
+
+    /* Concatenate CR & LF */
+    Str_Cat_N(pOut, STR_CR_LF, OutSize);
+
+    return (uint16_t)strlen(pOut);
+}
+#endif
+
 /* ========================================================================== */
 /**
  * \brief  Rotates the Event Log.
@@ -847,6 +1277,9 @@ static bool CreateSDCardDataDirectories(Logger * const me)
         /* Copy the current active directory path to the Global path */
         Str_Copy_N((CPU_CHAR *)&me->ActiveDataDirPath, (CPU_CHAR *)pDirPath, FS_CFG_MAX_PATH_NAME_LEN);
 
+        /* New data directory is the newest in the RDF retention index */
+        RdfIndexNewDir(u16IdxLevelTwo + u16IdxLevelOne);
+
         /* Success */
         bStatus = false;
 
@@ -855,6 +1288,193 @@ static bool CreateSDCardDataDirectories(Logger * const me)
     return bStatus;
 }
 
+/* ========================================================================== */
+/**
+ * \brief  Checks for an L2 data directory.
+ *
+ * \param   u16IdxLevelOne - L1 directory index [e.g.: data_000051]. 0 to check for the L1 directory only.
+ * \param   u16Dir         - L2 data directory number [e.g.: 000052]
+ *
+ * \note    Uses RdfIndexPath - call with pRdfIndexMutex held.
+ *
+ * \return  true if the directory exists
+ *
+ * ========================================================================== */
+static bool RdfDirExists(uint16_t u16IdxLevelOne, uint16_t u16Dir)
+{
+    FS_ENTRY_INFO   xFindInfo;          /* FS Directory Info */
+
+    memset(RdfIndexPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
+    if (0u == u16IdxLevelOne)
+    {
+        Str_FmtPrint((CPU_CHAR *)RdfIndexPath, sizeof(RdfIndexPath), "%s\\%s\\%s_%06d",
+                     SDCARD_ROOT_DIR, DATA_DIR, DATA_DIR, RDF_DIR_LEVEL_ONE(u16Dir));
+    }
+    else
+    {
+        Str_FmtPrint((CPU_CHAR *)RdfIndexPath, sizeof(RdfIndexPath), "%s\\%s\\%s_%06d\\%06d",
+                     SDCARD_ROOT_DIR, DATA_DIR, DATA_DIR, u16IdxLevelOne, u16Dir);
+    }
+
+    return (FS_ERR_ENTRY_NOT_FOUND != FsQueryDir(RdfIndexPath, &xFindInfo));
+}
+
+/* ========================================================================== */
+/**
+ * \brief  Rebuilds the RDF retention index from the data directory tree.
+ *
+ * \details Used when the index file is missing or invalid. Finds the oldest
+ *          and newest L2 data directories with directory queries only; RDF
+ *          files are not probed.
+ *
+ * \note    Call with pRdfIndexMutex held.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void RdfIndexRebuild(void)
+{
+    uint16_t u16Dir;            /* L2 data directory number */
+    uint16_t u16IdxLevelOne;    /* L1 directory index */
+
+    memset(&RdfIndex, 0, sizeof(RdfIndex));
+    RdfIndex.FileTypeId = FILE_TYPE_ID_RDF_INDEX;
+    RdfIndex.Version    = RDF_INDEX_VERSION;
+
+    /* Oldest: first existing L2 directory. Skip whole L1 directories that no longer exist. */
+    u16Dir = 1u;
+    while ((u16Dir < MAX_DIR_LIMIT) && !RdfDirExists(RDF_DIR_LEVEL_ONE(u16Dir), u16Dir))
+    {
+        u16Dir = RdfDirExists(0u, u16Dir) ? (u16Dir + 1u) : (RDF_DIR_LEVEL_ONE(u16Dir) + MAX_SUBDIR_PER_MAINDIR);
+    }
+    RdfIndex.OldestDir = u16Dir;
+    RdfIndex.NewestDir = u16Dir;
+
+    /* Newest: last existing L1 directory, then last existing L2 directory within it */
+    for (u16IdxLevelOne = RDF_DIR_LEVEL_ONE(u16Dir) + MAX_SUBDIR_PER_MAINDIR;
+         (u16IdxLevelOne < MAX_DIR_LIMIT) && RdfDirExists(0u, u16IdxLevelOne);
+         u16IdxLevelOne += MAX_SUBDIR_PER_MAINDIR)
+    {
+    }
+    u16IdxLevelOne -= MAX_SUBDIR_PER_MAINDIR;
+
+    for (u16Dir = MAX(u16IdxLevelOne, RdfIndex.OldestDir);
+         (u16Dir < (u16IdxLevelOne + MAX_SUBDIR_PER_MAINDIR)) && RdfDirExists(u16IdxLevelOne, u16Dir);
+         u16Dir++)
+    {
+        RdfIndex.NewestDir = u16Dir;
+    }
+
+    Log(DBG, "RDF Index: Rebuilt, Oldest %d, Newest %d", RdfIndex.OldestDir, RdfIndex.NewestDir);
+}
+
+/* ========================================================================== */
+/**
+ * \brief  Loads the RDF retention index.
+ *
+ * \details Reads the index from the SD card, once. Rebuilds it if the file is
+ *          missing or fails validation.
+ *
+ * \note    Call with pRdfIndexMutex held.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void RdfIndexLoad(void)
+{
+    FS_ERR   eFsErr;            /* FS Status Return */
+    FS_FILE  *pFile;            /* Index file */
+    uint32_t BytesRead;         /* Bytes read from index file */
+
+    if (!RdfIndexLoaded)
+    {
+        BytesRead = 0;
+        memset(RdfIndexPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
+        Str_FmtPrint((CPU_CHAR *)RdfIndexPath, sizeof(RdfIndexPath), "%s\\%s\\%s", SDCARD_ROOT_DIR, DATA_DIR, RDF_INDEX_NAME);
+
+        eFsErr = FsOpen(&pFile, RdfIndexPath, FS_MODE_R);
+        if (FS_ERR_NONE == eFsErr)
+        {
+            FsRead(pFile, (uint8_t *)&RdfIndex, sizeof(RdfIndex), &BytesRead);
+            FsClose(pFile);
+        }
+
+        if ((sizeof(RdfIndex) != BytesRead) ||
+            (FILE_TYPE_ID_RDF_INDEX != RdfIndex.FileTypeId) ||
+            (RDF_INDEX_VERSION != RdfIndex.Version) ||
+            (RdfIndex.Crc != CRC32(0, (uint8_t *)&RdfIndex, (sizeof(RdfIndex) - sizeof(RdfIndex.Crc)))))
+        {
+            RdfIndexRebuild();
+            RdfIndexSave();
+        }
+
+        RdfIndexLoaded = true;
+    }
+}
+
+/* ========================================================================== */
+/**
+ * \brief  Saves the RDF retention index to the SD card.
+ *
+ * \note    Call with pRdfIndexMutex held.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void RdfIndexSave(void)
+{
+    FS_ERR   eFsErr;            /* FS Status Return */
+    FS_FILE  *pFile;            /* Index file */
+
+    RdfIndex.Crc = CRC32(0, (uint8_t *)&RdfIndex, (sizeof(RdfIndex) - sizeof(RdfIndex.Crc)));
+
+    memset(RdfIndexPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
+    Str_FmtPrint((CPU_CHAR *)RdfIndexPath, sizeof(RdfIndexPath), "%s\\%s\\%s", SDCARD_ROOT_DIR, DATA_DIR, RDF_INDEX_NAME);
+
+    eFsErr = FsOpen(&pFile, RdfIndexPath, FS_MODE_W);
+    if (FS_ERR_NONE == eFsErr)
+    {
+        FsWrite(pFile, (uint8_t *)&RdfIndex, sizeof(RdfIndex), NULL);
+        FsClose(pFile);
+    }
+    else
+    {
+        Log(DBG, "RDF Index: Save Failed, %d", eFsErr);
+    }
+}
+
+/* ========================================================================== */
+/**
+ * \brief  Records a new data directory in the RDF retention index.
+ *
+ * \param   u16Dir - L2 data directory number of the new directory
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void RdfIndexNewDir(uint16_t u16Dir)
+{
+    uint8_t OsError;            /* OS errors */
+
+    OSMutexPend(pRdfIndexMutex, OS_WAIT_FOREVER, &OsError);
+    RdfIndexLoad();
+    if (RdfIndex.OldestDir > u16Dir)
+    {
+        /* No data directories were found when the index was built */
+        RdfIndex.OldestDir  = u16Dir;
+        RdfIndex.OldestFile = 0;
+    }
+    RdfIndex.NewestDir = u16Dir;
+    RdfIndexSave();
+    OSMutexPost(pRdfIndexMutex);
+}
+
 /* ========================================================================== */
 /**
  * \brief  This function initiates cleanup of older RDF files on SD Card.
@@ -902,20 +1522,8 @@ void CleanupOldRdfFiles(void *pRdfCleanupSize)
             }
         }
 
-        /* Change to "sdcard:0:\\data" directory */
-        memset(pDirPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
-        Str_FmtPrint((CPU_CHAR *)pDirPath, sizeof(pDirPath), "%s\\%s", SDCARD_ROOT_DIR, DATA_DIR);
-        eFsErr = FsChangeDir(pDirPath);
-        if (FS_ERR_NONE != eFsErr)
-        {
-            Log(DBG, "Logger: FsChangeDir '%s', Failed", SDCARD_ROOT_DIR);
-            break;
-        }
-        else
-        {
-            /* Search for rdf files in Level1 and Level2 Data folders   */
-            SearchOldRdfFiles(*((uint32 *)pRdfCleanupSize));
-        }
+        /* Delete the oldest rdf files listed by the RDF index */
+        DeleteOldRdfFiles(*((uint32 *)pRdfCleanupSize));
     } while (false);
 
     /* wait for the task to be deleted */
@@ -931,169 +1539,100 @@ void CleanupOldRdfFiles(void *pRdfCleanupSize)
     }
 }
 
-/* ========================================================================== */
-/**
- * \brief  This function  deletes older RDF files on SD Card.
- *
- * \details This function iterates through all the Data directories and finds Older RDF files
- *          and deletes them from SD Card. Number of RDF files to be deleted is dependent
- *          on the "Requested Cleanup size" passed to this function. After the cleanup is
- *          completed a signal is posted to the Logger AO.
- *
- * \todo    02/12/21 CPK - This function could be moved to rdf.c
- *
- * \param   CleanupSize - memory size that needs to be cleaned up. Used to decide the cleanup completion.
- *
- * \return  None
- *
- * ========================================================================== */
-static bool SearchOldRdfFiles(FS_FILE_SIZE CleanupSize)
-{
-    uint16_t        u16IdxLevelOne;     /* Data folder Index One [e.g.: data_000001] */
-    uint16_t        u16IdxLevelTwo;     /* Data folder Index Two [e.g.: 000001] */
-    FS_ERR          eFsErr;             /* FS Status Return */
-    FS_ENTRY_INFO   xFindInfo;                              /* FS Directory Info */
-    bool CleanupDone;                                       /* Flag indicating cleanup done */
-
-    CleanupDone = false;
-    Log(DBG, "RDF Cleanup: Cleanup Task Started");
-
-    do
-    {
-        /* If we are here, then we must be in "sdcard:0:\\data" directory . */
-        /* Look for proper L1 & L2 folders */
-        u16IdxLevelOne = 1u;
-        u16IdxLevelTwo = 0u;
-        /* Now lets find the LAST L1 directory, "sdcard:0:\\data\data_XXXXXX" */
-        for (u16IdxLevelOne =  1u;
-             ((u16IdxLevelOne < MAX_DIR_LIMIT) && (!CleanupDone));
-             u16IdxLevelOne += MAX_SUBDIR_PER_MAINDIR)
-        {
-            /* Lets check for "data_000051, data_000101, data_000151 etc" folders */
-            memset(pDirPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
-            Str_FmtPrint((CPU_CHAR *)pDirPath, sizeof(pDirPath),
-                         "%s_%06d",
-                         DATA_DIR, u16IdxLevelOne);
-            eFsErr = FsQueryDir(pDirPath, &xFindInfo);
-            if (eFsErr == FS_ERR_ENTRY_NOT_FOUND)
-            {
-                Log(DBG, "Logger: L1 FsChangeDir '%s', Failed", pDirPath);
-                break; /* break if L1 folder not found */
-            }
-
-            /* If we are here, then we know the proper L1 Directory. */
-            /* Now lets find the L2 directory, "sdcard:0:\\data\data_XXXXXX\XXXXXX" */
-            for (u16IdxLevelTwo = u16IdxLevelOne;
-                 u16IdxLevelTwo < (u16IdxLevelOne + MAX_SUBDIR_PER_MAINDIR);
-                 u16IdxLevelTwo++)
-            {
-                if ( CleanupDone )
-                {
-                    break;
-                }
-                /* Search RDF files in "000051, 000052, 000054 etc", or "000101, 000102, 000103 etc" folders */
-                memset(pDirPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
-                Str_FmtPrint((CPU_CHAR *)pDirPath, sizeof(pDirPath),
-                             "%s_%06d\\%06d",
-                             DATA_DIR, u16IdxLevelOne, u16IdxLevelTwo );
-                eFsErr = FsQueryDir(pDirPath, &xFindInfo);
-
-                if (eFsErr == FS_ERR_ENTRY_NOT_FOUND)
-                {
-                    Log(DBG, "Logger: L2 FsChangeDir '%s', Failed", pDirPath);
-                    break;
-                }
-                else
-                {
-                    /* Valid Data folder found - if we are here search and delete rdf files */
-                    CleanupDone = DeleteOldRdfFiles(CleanupSize, u16IdxLevelOne, u16IdxLevelTwo);
-                } /* Else - Valid L2 folder found*/
-            } /* Search Valid L2 Directory*/
-        } /* Search Valid L1 Directory*/
-    } while ( false );
-
-return false;
-}
-
 /* ========================================================================== */
 /**
  * \brief  This function deletes older RDF files on SD Card.
  *
- * \details This function iterates through specified Data directories and finds Older RDF files
- *          and deletes them from SD Card. Number of RDF files to be deleted is dependent
- *          on the "Requested Cleanup size" passed to this function. After the cleanup is
- *          completed a signal is posted to the Logger AO.
+ * \details This function deletes the oldest RDF files listed by the RDF retention
+ *          index, oldest data directory first, until the "Requested Cleanup size"
+ *          is reached. Each file costs a single FsGetInfo; an exhausted directory
+ *          costs one more. The active (newest) data directory is never touched.
  *
  * \todo    02/12/21 CPK - This function could be moved to rdf.c
  *
  * \param   CleanupSize - memory size that needs to be cleaned up. Used to decide the cleanup completion.
- * \param   u16IdxLevelOne - Directory level1 indicating Data_xxxxxx folder in Data directory.
- * \param   u16IdxLevelTwo - Directory level2 indicating Data_xxxxxx\yyyyyy\ folder in Data_xxxxxx directory.
  *
  * \return  completion status based on the  memory deleted(MemSize) compared to actual memory to be cleanedup(CleanupSize)
  *
  * ========================================================================== */
-static bool DeleteOldRdfFiles(FS_FILE_SIZE CleanupSize, uint16_t u16IdxLevelOne, uint16_t u16IdxLevelTwo)
+static bool DeleteOldRdfFiles(FS_FILE_SIZE CleanupSize)
 {
     FS_ERR          eFsErr;                                 /* FS Status Return */
-    uint16_t        RdfFileNumber;                          /* rdf file name */
     FS_ENTRY_INFO   RdfFileInfo;                            /* rdf Info */
-    FS_FILE         *pFile;                                 /* rdf file pointer */
+    uint8_t         OsError;                                /* OS errors */
+    uint32_t        RdfFileCount;                           /* rdf files deleted */
     bool CleanupDone;                                       /* Flag indicating cleanup done */
 
-    pFile = NULL;
     CleanupDone = false;
-    /* RDF files are sequentually named as 00000.rdf, 00001.rdf etc.  */
-    RdfFileNumber = 0x0;
+    RdfFileCount = 0;
+    Log(DBG, "RDF Cleanup: Cleanup Task Started");
 
-    do
+    OSMutexPend(pRdfIndexMutex, OS_WAIT_FOREVER, &OsError);
+    RdfIndexLoad();
+
+    while ((!CleanupDone) && (RdfIndex.OldestDir < RdfIndex.NewestDir))
     {
-        memset(pDirPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
-        Str_FmtPrint((CPU_CHAR *)pDirPath, sizeof(pDirPath),
-                     "%s_%06d\\%06d\\%05d.rdf",
-                     DATA_DIR, u16IdxLevelOne, u16IdxLevelTwo,RdfFileNumber);
+        /* RDF files are sequentually named as 00000.rdf, 00001.rdf etc.  */
+        memset(RdfIndexPath, NUL, FS_CFG_MAX_PATH_NAME_LEN);
+        Str_FmtPrint((CPU_CHAR *)RdfIndexPath, sizeof(RdfIndexPath),
+                     "%s\\%s\\%s_%06d\\%06d\\%05d.rdf",
+                     SDCARD_ROOT_DIR, DATA_DIR, DATA_DIR, RDF_DIR_LEVEL_ONE(RdfIndex.OldestDir), RdfIndex.OldestDir, RdfIndex.OldestFile);
+
         /*  RDF File exists ? */
-        eFsErr = FsOpen(&pFile, pDirPath, FS_MODE_R);
-        if (FS_ERR_NONE != eFsErr)
+        eFsErr = FsGetInfo(RdfIndexPath, &RdfFileInfo);
+        if ((FS_ERR_NONE != eFsErr) || (MAX_RDF_FILE_LIMIT <= RdfIndex.OldestFile))
         {
-            /* break - we dint find the sequential RDF File name */
-            break;
+            /* No more sequential RDF files in this directory - move on to the next one */
+            RdfIndex.OldestDir++;
+            RdfIndex.OldestFile = 0;
+            continue;
         }
 
-        FsClose(pFile);
-        /* Read rdf file size and increment total memory cleanedup */
-        FsGetInfo(pDirPath, &RdfFileInfo);
         /// \todo 12/02/2021 CPK Remove below macro - Debug purpose only to prevent accidental deletion
         #ifdef ENABLE_RDF_DEL
-        FsDelete(pDirPath);
+        eFsErr = FsDelete(RdfIndexPath);
         if (FS_ERR_NONE != eFsErr)
         {
-            Log(DBG, " RDF Cleanup: RDF-File '%s'Delete, Failed");
-            /* break if we dont find the sequential RDF File name */
+            Log(DBG, " RDF Cleanup: RDF-File '%s'Delete, Failed", RdfIndexPath);
             break;
         }
-        #endif
+
+        /* Only a deleted file frees space or moves the oldest file on */
         MemSize += RdfFileInfo.Size;
-        Log(DBG, " RDF Cleanup: Deleted RDF-File '%s File_Size %ld",pDirPath, RdfFileInfo.Size);
+        RdfFileCount++;
+        RdfIndex.OldestFile++;
+        Log(DBG, " RDF Cleanup: Deleted RDF-File '%s File_Size %ld", RdfIndexPath, RdfFileInfo.Size);
+        #else
+        /* Deletion disabled - the oldest file stays, and so does the index */
+        Log(DBG, " RDF Cleanup: Deletion disabled, RDF-File '%s' kept", RdfIndexPath);
+        break;
+        #endif
 
         if ( MemSize > CleanupSize)
         {
-            /*  memory cleanup size acheived - post signal about the completion */
+            /*  memory cleanup size acheived */
             CleanupDone = true;
-            Log(DBG, "RDF Cleanup: ------------------------------------------------------------");
-            Log(DBG, "RDF Cleanup: Cleanup Finished");
-            Log(DBG, "RDF Cleanup: %d.RDF Files Deleted, Memory Requested %ld , Memory Added %ld", RdfFileNumber,CleanupSize,MemSize);
-            Log(DBG, "RDF Cleanup: ------------------------------------------------------------");
-            MemSize = 0x0;
-            /* Allow Enough time to allow handle to startup and be able to receive signals */
-            OSTimeDly(SEC_10);
             break;
         }
+
         /* This is low priority background task - allow time for other tasks */
-        OSTimeDly(SEC_1);
-        RdfFileNumber++;
-    } while ( MAX_RDF_FILE_LIMIT > RdfFileNumber); /* While we are still searching */
-return CleanupDone;
+        OSMutexPost(pRdfIndexMutex);
+        OSTimeDly(RDF_CLEANUP_DELAY);
+        OSMutexPend(pRdfIndexMutex, OS_WAIT_FOREVER, &OsError);
+    }
+
+    #ifdef ENABLE_RDF_DEL
+    RdfIndexSave();
+    #endif
+    OSMutexPost(pRdfIndexMutex);
+
+    Log(DBG, "RDF Cleanup: ------------------------------------------------------------");
+    Log(DBG, "RDF Cleanup: Cleanup %s", CleanupDone ? "Finished" : "Incomplete");
+    Log(DBG, "RDF Cleanup: %d.RDF Files Deleted, Memory Requested %ld , Memory Added %ld", RdfFileCount, CleanupSize, MemSize);
+    Log(DBG, "RDF Cleanup: ------------------------------------------------------------");
+    MemSize = 0x0;
+
+    return CleanupDone;
 }
 
 /* ========================================================================== */
@@ -1455,13 +1994,9 @@ static QState Logger_Operate(Logger * const me, QEvt const * const e) {
         }
         /*.${AOs::Logger::SM::Operate::PRINTF} */
         case PRINTF_SIG: {
-            QEVENT_LOG_MSG *pLog;
-
-            pLog = (QEVENT_LOG_MSG *)e;
-
             AO_TimerRearm(&me->Timer, FLUSH_EVENT_LOG_TIMER_INTERVAL_LONG);    // Restart timer. Do not timeout till period of no message activity
 
-            SendMessageToLog(me, EVENT_LOG_FILE, pLog->Msg, strlen((char *)pLog->Msg));
+            LogProcessMsgSignal(me, EVENT_LOG_FILE, e);
 
             if (!me->EventLogIsDirty)        // File not dirty yet. Turn on SDHC LED
             {
@@ -1519,13 +2054,9 @@ static QState Logger_Operate(Logger * const me, QEvt const * const e) {
         }
         /*.${AOs::Logger::SM::Operate::SECURITY_LOG} */
         case SECURITY_LOG_SIG: {
-            QEVENT_LOG_MSG *pLog;
-
-            pLog = (QEVENT_LOG_MSG *)e;
-
             AO_TimerRearm(&me->Timer, FLUSH_EVENT_LOG_TIMER_INTERVAL_LONG);    // Restart timer. Do not timeout till period of no message activity
 
-            SendMessageToLog(me, SECURITY_LOG_FILE, pLog->Msg, strlen((char *)pLog->Msg));
+            LogProcessMsgSignal(me, SECURITY_LOG_FILE, e);
 
             if (!me->SecurityLogIsDirty)
             {
@@ -1600,6 +2131,9 @@ static QState Logger_Operate(Logger * const me, QEvt const * const e) {
 /*.${AOs::LoggerCtor} ......................................................*/
 void LoggerCtor(void) {
     Logger *me = (Logger *)AO_Logger;
+    uint8_t OsError;
+
+    pRdfIndexMutex = SigMutexCreate("RDF-INDEX", &OsError);    // RDF index shared with the cleanup task
 
     AO_TimerCtor(&me->Timer, &me->super, TIMEOUT_SIG);  // Build timer
     AO_TimerCtor(&me->SDCardPresenceTimer, &me->super, SD_CARD_PRESENCE_TIMEOUT_SIG);  // Build timer
@@ -1632,6 +2166,11 @@ void LoggerCtor(void) {
  *          - Push the string to circular buffer.
  *          - Posts the Log Msg Request to Log Msg Queue.
  *
+ *          With LOG_DEFERRED_FORMAT defined, only the format string pointer,
+ *          the prefix fields and the raw arguments are captured here. The
+ *          string is created by the Logger AO (LogRenderRecord), so the
+ *          critical section only covers the Log counter update.
+ *
  * \param   eLogFile  - Indicates the Log file the message to be Logged. LOG_FILE enumerates various Log files
  * \param   eLogLevel - Log Level Enum
  * \param   eLogGroup - Log Group Enum [By default it will be LOG_GROUP_IDENTIFIER,
@@ -1649,8 +2188,13 @@ void LogMsg(LOG_FILE eLogFile, LOG_LEVEL eLogLevel, LOG_GROUP eLogGroup,
     OS_CPU_SR       cpu_sr;                             // Status register for critical section
     va_list         xArguments;                         /* variadic arguments */
     uint32_t        u32MilliSeconds;                    /* Millisecs up time */
+#ifdef LOG_DEFERRED_FORMAT
+    QEVENT_LOG_RECORD *pLogRecord;                      /* Pointer to deferred log record signal */
+    SIGNAL          Sig;                                /* Log signal */
+#else
     uint16_t        u16StringLen;                       /* String Length */
     QEVENT_LOG_MSG  *pLogMsg;                           /* Pointer to log message signal */
+#endif
     static uint16_t u16LogCounter;                      /* Logger Counter, Rollover allowed. */
 
     do
@@ -1671,6 +2215,45 @@ void LogMsg(LOG_FILE eLogFile, LOG_LEVEL eLogLevel, LOG_GROUP eLogGroup,
         /* Get the time in milliseconds */
         u32MilliSeconds = SigTime();
 
+#ifdef LOG_DEFERRED_FORMAT
+        /* Get new log record */
+        if (EVENT_LOG_FILE == eLogFile)
+        {
+            Sig = PRINTF_SIG;
+        }
+        else if (SECURITY_LOG_FILE == eLogFile)
+        {
+            Sig = SECURITY_LOG_SIG;
+        }
+        else
+        {
+            break;
+        }
+
+        pLogRecord = AO_EvtNew(Sig, sizeof(QEVENT_LOG_RECORD));
+        BREAK_IF(NULL == pLogRecord);                          // EvtNew failed.
+
+        pLogRecord->pFormatString = pcFormatString;
+        pLogRecord->TimeStamp     = u32MilliSeconds;
+        pLogRecord->LineNumber    = u16LineNumber;
+        pLogRecord->LogLevel      = (uint8_t)eLogLevel;
+        pLogRecord->LogGroup      = (uint8_t)eLogGroup;
+
+        /* Capture the raw arguments - formatted later in the Logger context */
+        va_start(xArguments, pcFormatString);
+        LogCaptureArgs(pLogRecord, xArguments);
+        va_end(xArguments);
+
+        OS_ENTER_CRITICAL();
+        pLogRecord->LogCounter = ++u16LogCounter;
+
+        /* Hook for Logger Count value Rollover Check */
+        TM_Hook(HOOK_LOGCNTROLLOVER, &u16LogCounter);
+        OS_EXIT_CRITICAL();
+
+        /* Post the signal */
+        AO_Post(AO_Logger, &pLogRecord->Event, NULL);
+#else
 /// \todo 05/27/2021 DAZ - Can we defer parsing to Logger object?
 /// \todo 05/27/2021 DAZ - Post or publish parsed string? (If done here rather than AO)
 
@@ -1724,6 +2307,7 @@ void LogMsg(LOG_FILE eLogFile, LOG_LEVEL eLogLevel, LOG_GROUP eLogGroup,
 
         /* Post the signal */
         AO_Post(AO_Logger, &pLogMsg->Event, NULL);
+#endif
 
     } while (false);
 }
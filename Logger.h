@@ -54,6 +54,12 @@ extern "C"
 #define SecurityLog(pcFormatString, var_args... )            (LogMsg(SECURITY_LOG_FILE, REQ, LOG_GROUP_IDENTIFIER, __LINE__, pcFormatString, ##var_args))
 
 #define MAX_LOG_STRING_LEN      (150u)               ///< Max Length possible for a single Log Msg
+#define LOG_RECORD_DATA_LEN     (128u)               ///< Max raw argument bytes captured by a deferred Log record
+
+/*  \note: With LOG_DEFERRED_FORMAT defined, LogMsg only captures the format string pointer and the raw
+    argument words. The text is rendered later by the Logger AO, outside of the caller's critical section.
+    Format strings must therefore be string literals (persistent memory). */
+#define LOG_DEFERRED_FORMAT
 /*  \note: Call the below if we want to print from ISR */
 #define LogFromIsr(pcFormatString, var_args... )     (LogMsgFromIsr(pcFormatString, ##var_args))
 
@@ -167,6 +173,21 @@ typedef struct
     uint8_t Msg[MAX_LOG_STRING_LEN];    ///< Log message
 } QEVENT_LOG_MSG;
 
+/// Deferred Log record event - rendered to text by the Logger AO
+typedef struct
+{
+    QEvt        Event;                          ///< QPC event header
+    const char *pFormatString;                  ///< Format string. Also serves as the format id for offline decoding
+    uint32_t    TimeStamp;                      ///< Up time in milliseconds at the time of the call
+    uint16_t    LineNumber;                     ///< Line number from where the Log message originated
+    uint16_t    LogCounter;                     ///< Log counter, rollover allowed
+    uint8_t     LogLevel;                       ///< Log level (LOG_LEVEL)
+    uint8_t     LogGroup;                       ///< Log group (LOG_GROUP)
+    uint8_t     ArgCount;                       ///< Number of conversions captured in Data
+    uint8_t     DataLen;                        ///< Number of bytes used in Data
+    uint8_t     Data[LOG_RECORD_DATA_LEN];      ///< Packed argument words and copied strings
+} QEVENT_LOG_RECORD;
+
 /******************************************************************************/
 /*                             Global Constant Declaration(s)                 */
 /******************************************************************************/
@@ -33,12 +33,20 @@ extern "C"
 /******************************************************************************/
 /*                             Global Variable Definitions(s)                 */
 /******************************************************************************/
+uint32_t  RdfRingOverflows;                     // RDF samples dropped - sample ring full
 
 /******************************************************************************/
 /*                             Local Define(s) (Macros)                       */
 /******************************************************************************/
 #define LOG_GROUP_IDENTIFIER    (LOG_GROUP_LOGGER)
 
+#define RDF_VARINT_DATA_MASK    (0x7Fu)         ///< Varint data bits per byte
+#define RDF_VARINT_MORE_BIT     (0x80u)         ///< Varint continuation bit
+#define RDF_VARINT_DATA_BITS    (7u)            ///< Varint data bits per byte
+
+/// Zigzag encode a signed difference so small magnitudes map to small unsigned values
+#define RDF_ZIGZAG(Delta)       ((uint32_t)(((uint32_t)(Delta) << 1) ^ (uint32_t)((int32_t)(Delta) >> 31)))
+
 /******************************************************************************/
 /*                             Local Type Definition(s)                       */
 /******************************************************************************/
@@ -76,13 +84,275 @@ static_assert((sizeof(RdfItemDefinitions) / sizeof(RdfItemDefinitions[0])) == MO
 RDF_OBJECT RdfObject[RDF_OBJECT_MAX];           // Storage for RDF objects
 static uint32_t  TotalDroppedRDFPackets;        // Dropped RDF packet count
 
+#ifdef RDF_SAMPLE_RING
+#pragma location=".sram"
+static uint8_t RdfRingBuf[RDF_OBJECT_MAX][RDF_RING_SIZE];  // RDF sample ring storage (RDF event pool budget)
+#endif
+
 /******************************************************************************/
 /*                             Local Function Prototype(s)                    */
 /******************************************************************************/
+static uint8_t RdfPutVarint(uint8_t *pData, uint32_t Value);
+static uint8_t RdfVarSize(VAR_TYPE VarType, RDF_COMPRESSION Compression);
+static uint8_t RdfPackSample(RDF_OBJECT *pRdf, uint8_t *pData);
+#ifdef RDF_SAMPLE_RING
+static uint16_t RdfRingUsed(RDF_RING *pRing);
+static void RdfRingNotify(RDF_OBJECT *pRdf);
+static void RdfRingDrain(RDF_OBJECT *pRdf, uint16_t End);
+#endif
 
 /******************************************************************************/
 /*                             Local Function(s)                              */
 /******************************************************************************/
+/* ========================================================================== */
+/**
+ * \brief   Write a value as an unsigned varint.
+ *
+ * \param   pData - Destination. Must hold RDF_VARINT_SIZE_MAX bytes.
+ * \param   Value - Value to write
+ *
+ * \return  Number of bytes written
+ *
+ * ========================================================================== */
+static uint8_t RdfPutVarint(uint8_t *pData, uint32_t Value)
+{
+    uint8_t Count;
+
+    Count = 0;
+
+    while (Value > RDF_VARINT_DATA_MASK)
+    {
+        pData[Count++] = (uint8_t)(Value & RDF_VARINT_DATA_MASK) | RDF_VARINT_MORE_BIT;
+        Value >>= RDF_VARINT_DATA_BITS;
+    }
+    pData[Count++] = (uint8_t)Value;
+
+    return Count;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Get the max number of bytes a packed variable takes.
+ *
+ * \param   VarType     - Variable type
+ * \param   Compression - Record compression
+ *
+ * \return  Max number of bytes
+ *
+ * ========================================================================== */
+static uint8_t RdfVarSize(VAR_TYPE VarType, RDF_COMPRESSION Compression)
+{
+    uint8_t Size;
+
+    switch (VarType)
+    {
+        case VAR_TYPE_INT8U:
+        case VAR_TYPE_INT8S:
+            Size = 1;
+            break;
+
+        case VAR_TYPE_INT16U:
+        case VAR_TYPE_INT16S:
+            Size = 2;
+            break;
+
+        case VAR_TYPE_INT32U:
+        case VAR_TYPE_INT32S:
+        case VAR_TYPE_FP32:
+            Size = 4;
+            break;
+
+        default:
+            Size = 0;
+            break;
+    }
+
+    if ((RDF_COMPRESSION_DELTA_VARINT == Compression) && (Size > 0))
+    {
+        Size = ((Size * BITS_PER_BYTE) + RDF_VARINT_DATA_BITS - 1) / RDF_VARINT_DATA_BITS;
+    }
+
+    return Size;
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Pack the selected RDF variables into a sample record.
+ *
+ * \details Variables are packed raw, or delta/varint encoded against the
+ *          previous sample, as selected by the RDF object's compression.
+ *
+ * \param   pRdf  - Pointer to the RDF object
+ * \param   pData - Destination. Must hold at least pRdf->SampleSize bytes.
+ *
+ * \return  Number of bytes packed
+ *
+ * ========================================================================== */
+static uint8_t RdfPackSample(RDF_OBJECT *pRdf, uint8_t *pData)
+{
+    RDF_VAR         *pVar;          // Pointer to RDF variable
+    RDF_VAR         *pPrevVar;      // Pointer to previous sample's RDF variable
+    uint16_t        StreamVars;     // List of variables to stream
+    uint8_t         Idx;            // Index for processing variable list
+    uint8_t         Count;          // Data byte count
+    uint8_t         Size;           // Raw variable size
+    uint32_t        Code;           // Encoded value
+
+    StreamVars = pRdf->StreamVars;  // Get list of variables to stream
+    Count = 0;
+
+    // Go through list & copy selected parameters
+    for (Idx = 0; Idx < pRdf->NumVars; Idx++)
+    {
+        if (StreamVars & 1)                                 // Check bit to see if corresponding parameter is selected
+        {
+            pVar = &pRdf->Var[Idx];                         // Point to selected variable in object
+            pPrevVar = &pRdf->PrevVar[Idx];
+            Size = RdfVarSize(RdfItemDefinitions[Idx].VarType, RDF_COMPRESSION_NONE);
+
+            if ((RDF_COMPRESSION_DELTA_VARINT == pRdf->Compression) && (Size > 0))
+            {
+                switch (RdfItemDefinitions[Idx].VarType)
+                {
+                    case VAR_TYPE_INT8U:
+                    case VAR_TYPE_INT8S:
+                        Code = RDF_ZIGZAG((int8_t)(pVar->Int8uVal - pPrevVar->Int8uVal));
+                        break;
+
+                    case VAR_TYPE_INT16U:
+                    case VAR_TYPE_INT16S:
+                        Code = RDF_ZIGZAG((int16_t)(pVar->Int16uVal - pPrevVar->Int16uVal));
+                        break;
+
+                    case VAR_TYPE_FP32:
+                        Code = pVar->Int32uVal ^ pPrevVar->Int32uVal;       // Raw bits - lossless
+                        break;
+
+                    default:
+                        Code = RDF_ZIGZAG((int32_t)(pVar->Int32uVal - pPrevVar->Int32uVal));
+                        break;
+                }
+
+                Count += RdfPutVarint(&pData[Count], Code);
+                *pPrevVar = *pVar;                          // Delta reference for the next sample
+            }
+            else
+            {
+                Mem_Copy(&pData[Count], (const void *)&pVar->Int8uVal, Size);   // Copy data (1, 2 or 4 bytes)
+                Count += Size;                                                  // Increment data byte count
+            }
+        }
+
+        StreamVars = StreamVars >> 1;   // Shift bitmap to next variable
+    }
+
+    return Count;
+}
+
+#ifdef RDF_SAMPLE_RING
+/* ========================================================================== */
+/**
+ * \brief   Get the number of bytes waiting in a sample ring.
+ *
+ * \param   pRing - Pointer to the sample ring
+ *
+ * \return  Number of bytes between Tail and Head
+ *
+ * ========================================================================== */
+static uint16_t RdfRingUsed(RDF_RING *pRing)
+{
+    return (uint16_t)((pRing->Head + RDF_RING_SIZE - pRing->Tail) % RDF_RING_SIZE);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Wake the Logger to write out the sample ring.
+ *
+ * \details Posts RDF_DATA_SIG when enough bytes are pending or the oldest
+ *          pending byte is older than RDF_RING_NOTIFY_TIME. Only one
+ *          notification is outstanding at a time; one that has not been
+ *          processed within RDF_RING_NOTIFY_TIME (post failed, Logger disabled)
+ *          is posted again. A failed post loses no samples.
+ *
+ * \param   pRdf - Pointer to the RDF object
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void RdfRingNotify(RDF_OBJECT *pRdf)
+{
+    QEVENT_RDF_RING *pEvent;        // Pointer to notification event
+    RDF_RING        *pRing;         // Sample ring
+    uint32_t        Now;            // Present time
+
+    pRing = &pRdf->Ring;
+    Now = SigTime();
+
+    do
+    {
+        if (pRing->NotifyPending)
+        {
+            BREAK_IF((Now - pRing->NotifyTime) < RDF_RING_NOTIFY_TIME);     // Logger has not had time to process the notification
+        }
+        else
+        {
+            BREAK_IF((RdfRingUsed(pRing) < RDF_RING_NOTIFY_SIZE) &&
+                     ((Now - pRing->NotifyTime) < RDF_RING_NOTIFY_TIME));   // Not enough pending yet
+        }
+
+        pEvent = AO_EvtNew(RDF_DATA_SIG, sizeof(QEVENT_RDF_RING));
+        BREAK_IF(NULL == pEvent);                                           // Samples stay in the ring - retry later
+
+        pEvent->pRdf = pRdf;
+        pRing->NotifyTime = Now;
+        pRing->NotifyPending = true;
+
+        /// \todo 11/15/2021 DAZ - See RdfOpen concerning unabstracted post call.
+        if (!QACTIVE_POST_X(AO_Logger, &pEvent->Event, 1, NULL))
+        {
+            pRing->NotifyPending = false;                                   // Samples stay in the ring - retry later
+        }
+    } while (false);
+}
+
+/* ========================================================================== */
+/**
+ * \brief   Write the sample ring out to the RDF file.
+ *
+ * \details Called by the Logger. Writes the bytes from Tail up to End (at
+ *          most two FsWrite calls, as the bytes may wrap) and releases them
+ *          to the producer. The bytes are discarded if the file is not open.
+ *
+ * \param   pRdf - Pointer to the RDF object
+ * \param   End  - Ring index to write up to
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void RdfRingDrain(RDF_OBJECT *pRdf, uint16_t End)
+{
+    RDF_RING    *pRing;             // Sample ring
+    uint16_t    Tail;               // Read index
+    uint16_t    Count;              // Contiguous bytes to write
+    uint32_t    BytesWritten;
+
+    pRing = &pRdf->Ring;
+    Tail = pRing->Tail;
+
+    while (Tail != End)
+    {
+        Count = (End > Tail) ? (End - Tail) : (RDF_RING_SIZE - Tail);
+
+        if (FsIsInitialized() && (pRdf->pFile != NULL))
+        {
+            FsWrite(pRdf->pFile, &pRing->pBuf[Tail], Count, &BytesWritten);
+        }
+
+        Tail = (Tail + Count) % RDF_RING_SIZE;
+        pRing->Tail = Tail;                                 // Release the bytes to the producer
+    }
+}
+#endif
 
 /******************************************************************************/
 /*                             Global Function(s)                             */
@@ -106,6 +376,7 @@ static uint32_t  TotalDroppedRDFPackets;        // Dropped RDF packet count
 RDF_OBJECT* RdfCreate(char *pName, uint8_t MotorNum, uint32_t SampleRate, uint16_t StreamVars)
 {
     RDF_OBJECT *pRdf;
+    uint8_t    Idx;
 
     do
     {
@@ -120,6 +391,12 @@ RDF_OBJECT* RdfCreate(char *pName, uint8_t MotorNum, uint32_t SampleRate, uint16
         pRdf->StreamVars = StreamVars;
         pRdf->SampleRate = SampleRate;
         pRdf->pFile = NULL;
+        pRdf->SampleSize = 0;
+        pRdf->Compression = RDF_COMPRESSION_DEFAULT;
+        memset(pRdf->PrevVar, 0, sizeof(pRdf->PrevVar));        // Delta reference starts at 0
+#ifdef RDF_SAMPLE_RING
+        pRdf->Ring.pBuf = RdfRingBuf[MotorNum];                 // Ring indexes are left alone - the Logger may still be draining
+#endif
 
         // Count the number of 1 bits (NumVars) in the StreamVars bitmap:
         while (StreamVars != 0)
@@ -128,6 +405,15 @@ RDF_OBJECT* RdfCreate(char *pName, uint8_t MotorNum, uint32_t SampleRate, uint16
             StreamVars = StreamVars >> 1;
         }
 
+        // Max size of one packed sample
+        for (Idx = 0, StreamVars = pRdf->StreamVars; Idx < pRdf->NumVars; Idx++, StreamVars >>= 1)
+        {
+            if (StreamVars & 1)
+            {
+                pRdf->SampleSize += RdfVarSize(RdfItemDefinitions[Idx].VarType, (RDF_COMPRESSION)pRdf->Compression);
+            }
+        }
+
     } while (false);
 
     return pRdf;
@@ -189,9 +475,21 @@ void RdfClose(RDF_OBJECT *pRdf)
 {
 #if !REFORMAT_BAD_SD_CARDS
     QEVENT_RDF_OPEN_CLOSE *pEvent;
+#ifdef RDF_SAMPLE_RING
+    bool MarkSet;                           // This close set the ring mark
+#endif
 
     if (pRdf != NULL)
     {
+#ifdef RDF_SAMPLE_RING
+        MarkSet = false;
+        if (!pRdf->Ring.MarkPending)        // A close already pending owns the mark - samples after it belong to the next file
+        {
+            pRdf->Ring.Mark = pRdf->Ring.Head;
+            pRdf->Ring.MarkPending = true;  // Logger writes the ring up to here, then closes the file
+            MarkSet = true;
+        }
+#endif
         pEvent = AO_EvtNew(RDF_CLOSE_SIG, sizeof(QEVENT_RDF_OPEN_CLOSE));
         if (pEvent)
         {
@@ -199,9 +497,16 @@ void RdfClose(RDF_OBJECT *pRdf)
             /// \todo 11/15/2021 DAZ - See RdfOpen
             if (!QACTIVE_POST_X(AO_Logger, &pEvent->Event, 1, NULL))    // If Logger event queue is full, bump dropped RDF packets count
             {
+                pEvent = NULL;
                 TotalDroppedRDFPackets += 1;
             }
         }
+#ifdef RDF_SAMPLE_RING
+        if ((NULL == pEvent) && MarkSet)
+        {
+            pRdf->Ring.MarkPending = false;     // No close coming - do not hold up the ring
+        }
+#endif
     }
 #endif
 }
@@ -255,8 +560,11 @@ void RdfVariableWrite(RDF_OBJECT *pRdf, MOT_STREAM_PARAMS VarIdx, void *pVoid)
 /**
  * \brief   Request an RDF object be written to the file.
  *
- * \details Create an RDF event, add the appropriate data and post the event
- *          to the Logger module.
+ * \details With RDF_SAMPLE_RING defined, the sample is packed into the RDF
+ *          object's sample ring and the Logger is notified once enough bytes
+ *          are pending (see RdfRingNotify). A sample that does not fit is
+ *          counted in RdfRingOverflows. Otherwise, create an RDF event, add
+ *          the appropriate data and post the event to the Logger module.
  *
  * \param   pRdf - Pointer to the RDF object
  *
@@ -265,11 +573,16 @@ void RdfVariableWrite(RDF_OBJECT *pRdf, MOT_STREAM_PARAMS VarIdx, void *pVoid)
  * ========================================================================== */
 void RdfWriteData(RDF_OBJECT *pRdf)
 {
+#ifdef RDF_SAMPLE_RING
+    RDF_RING        *pRing;         // Sample ring
+    uint8_t         Sample[RDF_SAMPLE_SIZE_MAX];    // Packed sample, if it wraps around the end of the ring
+    uint16_t        Head;           // Write index
+    uint16_t        Room;           // Contiguous bytes from Head to the end of the ring
+    uint8_t         Count;          // Packed sample size
+#else
     QEVENT_RDF_DATA *pEvent;        // Pointer to data event
-    RDF_VAR         *pVar;          // Pointer to RDF variable
-    uint16_t        StreamVars;     // List of variables to stream
-    uint8_t         Idx;            // Index for processing variable list
-    uint8_t         *pData;         // Pointer to data to retrieve from RDF variable
+    RDF_VAR         RestoreVar[MOT_STREAM_MAX_VARS];    // PrevVar to restore if the sample is dropped
+#endif
     bool            Status;         // Operation status - True if error
 
     do
@@ -278,58 +591,55 @@ void RdfWriteData(RDF_OBJECT *pRdf)
         BREAK_IF(!FsIsInitialized());                           // Quit if file system not initialized
         BREAK_IF(NULL == pRdf);                                 // Quit if null RDF pointer
 
-        pEvent = AO_EvtNew(RDF_DATA_SIG, sizeof(QEVENT_RDF_DATA));  // Create new event
-        BREAK_IF(NULL == pEvent);                                   // Quit if new event creation failed
-
-        StreamVars = pRdf->StreamVars;  // Get list of variables to stream
-        pEvent->pRdf = pRdf;            // Set pointer to RDF object
-        pEvent->Count = 0;              // Initialize data byte count
+#ifdef RDF_SAMPLE_RING
+        pRing = &pRdf->Ring;
+        Status = false;                                         // Ring overflow is not an event failure
 
-        // Go through list & copy selected parameters
+        if ((RdfRingUsed(pRing) + pRdf->SampleSize) >= RDF_RING_SIZE)
+        {
+            RdfRingOverflows++;                                 // Logger is behind - drop the sample
+            break;
+        }
 
-        pData = pEvent->Data;                                   // Set destination pointer to data area of event
+        if ((pRing->Head == pRing->Tail) && !pRing->NotifyPending)
+        {
+            pRing->NotifyTime = SigTime();                      // Age of pending bytes starts with this sample
+        }
 
-        for (Idx = 0; Idx < pRdf->NumVars; Idx++)
+        Head = pRing->Head;
+        Room = RDF_RING_SIZE - Head;
+        if (Room >= pRdf->SampleSize)
+        {
+            Count = RdfPackSample(pRdf, &pRing->pBuf[Head]);    // Pack in place
+        }
+        else
         {
-            if (StreamVars & 1)                                 // Check bit to see if corresponding parameter is selected
+            Count = RdfPackSample(pRdf, Sample);                // Sample may wrap - pack aside and copy in two parts
+            memcpy(&pRing->pBuf[Head], Sample, MIN(Count, Room));
+            if (Count > Room)
             {
-                pVar = &pRdf->Var[Idx];                         // Point to selected variable in object
-
-                switch (RdfItemDefinitions[Idx].VarType)
-                {
-                    case VAR_TYPE_INT8U:
-                    case VAR_TYPE_INT8S:
-                        Mem_Copy(pData, (const void *)pVar->Int8uVal, 1);   // Copy data BYTE
-                        pData += 1;                                         // Increment destination pointer
-                        pEvent->Count += 1;                                 // Increment data byte count
-                        break;
-
-                    case VAR_TYPE_INT16U:
-                    case VAR_TYPE_INT16S:
-                        Mem_Copy(pData, (const void *)&pVar->Int8uVal, 2);  // Copy data WORD (2 bytes, 16 bit)
-                        pData += 2;
-                        pEvent->Count += 2;
-                        break;
-
-                    case VAR_TYPE_INT32U:
-                    case VAR_TYPE_INT32S:
-                    case VAR_TYPE_FP32:
-                        Mem_Copy(pData, (const void *)&pVar->Int8uVal, 4);  // Copy data WORD (4 bytes, 32 bit)
-                        pData += 4;
-                        pEvent->Count += 4;
-                        break;
-
-                    default:
-                        break;
-                }
+                memcpy(pRing->pBuf, &Sample[Room], Count - Room);
             }
-
-            StreamVars = StreamVars >> 1;   // Shift bitmap to next variable
         }
+        pRing->Head = (Head + Count) % RDF_RING_SIZE;           // Publish the sample to the Logger
+
+        RdfRingNotify(pRdf);
+#else
+        pEvent = AO_EvtNew(RDF_DATA_SIG, sizeof(QEVENT_RDF_DATA));  // Create new event
+        BREAK_IF(NULL == pEvent);                                   // Quit if new event creation failed
+
+        pEvent->pRdf = pRdf;                                    // Set pointer to RDF object
+        memcpy(RestoreVar, pRdf->PrevVar, sizeof(RestoreVar));
+        pEvent->Count = RdfPackSample(pRdf, pEvent->Data);      // Copy selected parameters
 
         /// \todo 11/15/2021 DAZ - See RdfOpen concerning unabstracted post call.
-        BREAK_IF(!QACTIVE_POST_X(AO_Logger, &pEvent->Event, 1, NULL));      // If Logger event queue is full, exit bad
+        if (!QACTIVE_POST_X(AO_Logger, &pEvent->Event, 1, NULL))   // If Logger event queue is full, exit bad
+        {
+            memcpy(pRdf->PrevVar, RestoreVar, sizeof(pRdf->PrevVar));          // Keep the delta reference in step with the file
+            break;
+        }
         Status = false;                                                     // No errors
+#endif
 
     } while (false);
 
@@ -419,8 +729,8 @@ void RdfProcessOpenSignal(QEvt const *const pEvent)
                 // var type
                 FsFileWrByte(pRdf->pFile, (uint8_t)RdfItemDefinitions[Idx].VarType);
 
-                // set compression to 0 (reserved for future use)
-                FsFileWrByte(pRdf->pFile, 0);
+                // record compression
+                FsFileWrByte(pRdf->pFile, pRdf->Compression);
             }
 
             StreamVars = StreamVars >> 1;   // Shift bit map to next variable
@@ -433,7 +743,8 @@ void RdfProcessOpenSignal(QEvt const *const pEvent)
  * \brief   Write the RDF event data to the SD file.
  *
  * \details Writes the data attached to the specified event to the file spedified
- *          in the event.
+ *          in the event. With RDF_SAMPLE_RING defined, the event is a notification
+ *          and the RDF object's sample ring is written out instead.
  *
  * \param   pEvent - Pointer to event to process
  *
@@ -443,6 +754,21 @@ void RdfProcessOpenSignal(QEvt const *const pEvent)
 void RdfProcessDataSignal(QEvt const *const pEvent)
 {
     RDF_OBJECT *pRdf;
+#ifdef RDF_SAMPLE_RING
+    RDF_RING *pRing;
+    uint16_t End;
+
+    pRdf = ((QEVENT_RDF_RING *)pEvent)->pRdf;           // Get pointer to RDF object
+    pRing = &pRdf->Ring;
+
+    pRing->NotifyPending = false;                       // Samples added from here on need a new notification
+    End = pRing->Head;                                  // Read Head before the mark - never write past a pending close
+    if (pRing->MarkPending)
+    {
+        End = pRing->Mark;
+    }
+    RdfRingDrain(pRdf, End);
+#else
     uint8_t Count;
     uint32_t BytesWritten;
 
@@ -456,6 +782,7 @@ void RdfProcessDataSignal(QEvt const *const pEvent)
             FsWrite(pRdf->pFile, ((QEVENT_RDF_DATA *)pEvent)->Data, Count, &BytesWritten);
         }
     }
+#endif
 }
 
 /* ========================================================================== */
@@ -477,6 +804,13 @@ void RdfProcessCloseSignal(QEvt const *const pEvent)
 
     if (pRdf)
     {
+#ifdef RDF_SAMPLE_RING
+        if (pRdf->Ring.MarkPending)
+        {
+            RdfRingDrain(pRdf, pRdf->Ring.Mark);        // Samples logged before the close
+            pRdf->Ring.MarkPending = false;
+        }
+#endif
         if ((pRdf->pFile != NULL) && FsIsInitialized())
         {
             FsClose(pRdf->pFile);
@@ -35,6 +35,23 @@ extern "C"
 #define RDF_OBJECT_MAX     (3u)
 #define RDF_FILEBUF_SIZE   (512u)
 
+/* With RDF_SAMPLE_RING defined, samples are packed straight into a per-RDF
+   single producer (motor servo) / single consumer (Logger) ring. The Logger is
+   woken by an occasional notification instead of one event per sample, and RDF
+   data no longer draws on the shared event pools. */
+#define RDF_SAMPLE_RING
+#define RDF_RING_SIZE           (EVENT_MSG_BUF_RDF_TOTAL_SIZE / RDF_OBJECT_MAX)   ///< Bytes per RDF sample ring (RDF pool budget split between RDF objects)
+#define RDF_RING_NOTIFY_SIZE    (RDF_FILEBUF_SIZE)  ///< Pending bytes that wake the Logger (one SD sector)
+#define RDF_RING_NOTIFY_TIME    (MSEC_500)          ///< Max age of pending bytes before the Logger is woken
+#define RDF_VARINT_SIZE_MAX     (5u)                ///< Max bytes of a 32 bit value encoded as a varint
+#define RDF_SAMPLE_SIZE_MAX     (MOT_STREAM_MAX_VARS * RDF_VARINT_SIZE_MAX)   ///< Max bytes of a single packed sample
+
+/* Compression applied to RDF records. Written in each variable header's
+   compression byte (previously reserved, always 0). Records stay uncompressed
+   until the host tools can decode RDF_COMPRESSION_DELTA_VARINT; bump
+   RDF_MINOR_REV along with the default. */
+#define RDF_COMPRESSION_DEFAULT (RDF_COMPRESSION_NONE)
+
 /// \todo 03/24/2022 DAZ - Implement the following as initialized enums?
 
 /// RDF Streaming flags:
@@ -81,6 +98,22 @@ typedef enum
     MOT_STREAM_MAX_VARS
 } MOT_STREAM_PARAMS;
 
+/// RDF record compression (variable header compression byte)
+///
+/// RDF_COMPRESSION_DELTA_VARINT - each variable is stored as an unsigned LEB128
+/// varint (7 bits per byte, least significant group first, bit 7 set if more
+/// bytes follow) of:
+///     - Integers: the zigzag encoded ((d << 1) ^ (d >> (w - 1))) difference d from
+///       the previous sample, computed modulo the variable width w (8/16/32 bits).
+///     - FP32: the raw bits XORed with the previous sample's raw bits.
+/// The previous value of every variable is 0 at the start of the file.
+typedef enum
+{
+    RDF_COMPRESSION_NONE         = 0,   ///< Raw little endian values
+    RDF_COMPRESSION_DELTA_VARINT = 1,   ///< Delta (integers) / XOR (floats) + varint
+    RDF_COMPRESSION_LAST
+} RDF_COMPRESSION;
+
 /// RDF data item definition
 typedef struct
 {
@@ -88,6 +121,19 @@ typedef struct
     char     ItemTypeName[MOT_RDF_NAMESIZE_ITEMDEF];    ///< Variable name (Including terminator)
 } RDF_ITEM_DEFINITION;
 
+/// RDF sample ring. Indexes run from 0 to RDF_RING_SIZE - 1; the ring is empty
+/// when Head == Tail, so it holds at most RDF_RING_SIZE - 1 bytes.
+typedef struct
+{
+    uint8_t           *pBuf;              ///< Ring storage (RDF_RING_SIZE bytes)
+    volatile uint16_t Head;               ///< Write index. Updated by the producer only.
+    volatile uint16_t Tail;               ///< Read index. Updated by the Logger only.
+    volatile uint16_t Mark;               ///< Head at RdfClose. The Logger reads no further until the close is processed.
+    volatile bool     MarkPending;        ///< Mark is valid
+    volatile bool     NotifyPending;      ///< Notification posted and not yet processed
+    uint32_t          NotifyTime;         ///< Time of the last notification (or of the first pending byte)
+} RDF_RING;
+
 /// RDF variable structure
 typedef struct
 {
@@ -110,11 +156,17 @@ typedef struct
     char      *pName;                     ///< RDF file name
     uint8_t   MotorNum;                   ///< Motor Id
     uint8_t   NumVars;                    ///< Number of variables in list
+    uint8_t   SampleSize;                 ///< Max bytes per packed sample
+    uint8_t   Compression;                ///< Record compression (RDF_COMPRESSION)
     uint16_t  StreamVars;                 ///< Variables to stream
     uint32_t  SampleRate;                 ///< Rate to log variables (milliseconds)
     FS_FILE   *pFile;                     ///< RDF file pointer
     RDF_VAR   Var[MOT_STREAM_MAX_VARS];   ///< RDF variables. See RdfItemDefinitions for variable type.
+    RDF_VAR   PrevVar[MOT_STREAM_MAX_VARS];   ///< Previous sample's variables (delta compression)
     uint8_t   FileBuf[RDF_FILEBUF_SIZE + MEMORY_FENCE_SIZE_BYTES];               ///< File buffer
+#ifdef RDF_SAMPLE_RING
+    RDF_RING  Ring;                       ///< Packed samples waiting for the Logger
+#endif
 } RDF_OBJECT;
 
 /// RDF file open/close event structure
@@ -130,9 +182,16 @@ typedef struct
     QEvt        Event;          ///< Event structure
     RDF_OBJECT  *pRdf;          ///< Pointer to RDF object to log to
     uint8_t     Count;          ///< Number of bytes to log
-    uint8_t     Data[64];       ///< Data to log. Ensure array is big enough for all defined variables.
+    uint8_t     Data[RDF_SAMPLE_SIZE_MAX];  ///< Data to log. Ensure array is big enough for all defined variables.
 } QEVENT_RDF_DATA;
 
+/// RDF sample ring notification structure (RDF_DATA_SIG when RDF_SAMPLE_RING is defined)
+typedef struct
+{
+    QEvt        Event;          ///< Event structure
+    RDF_OBJECT  *pRdf;          ///< Pointer to RDF object with pending samples
+} QEVENT_RDF_RING;
+
 /******************************************************************************/
 /*                             Global Constant Declaration(s)                 */
 /******************************************************************************/
@@ -141,6 +200,7 @@ typedef struct
 /*                             Global Variable Declaration(s)                 */
 /******************************************************************************/
 extern uint32_t  TotalDroppedRDFPackets;
+extern uint32_t  RdfRingOverflows;
 
 /******************************************************************************/
 /*                             Global Function Prototype(s)                   */
@@ -411,9 +411,8 @@ static ONEWIRE_STATUS DeviceWriteTest(AM_DEVICE_INFO *pDevData)
     Status = ONEWIRE_STATUS_OK;
     do
     {
-        /* Read the EEPROM Data 64bytes*/
-        EepromStatus = L3_OneWireEepromRead(pDevData->DeviceUID, OW_EEPROM_PAGE_NUM, ReadData);
-        EepromStatus = L3_OneWireEepromRead(pDevData->DeviceUID, OW_EEPROM_PAGE_NUM2, &ReadData[OW_EEPROM_PAGE_OFFSET]);
+        /* Read the EEPROM Data 64bytes, as last read or written. The read back below is from the device */
+        EepromStatus = L3_OneWireEepromReadCached(pDevData->DeviceUID, OW_EEPROM_PAGE_NUM, 2, ReadData);
         if (OW_EEP_STATUS_OK != EepromStatus)
         {
             Status = ONEWIRE_STATUS_READ_ERROR;
@@ -39,7 +39,11 @@ extern "C"
 /******************************************************************************/
 #define LOG_GROUP_IDENTIFIER                (LOG_GROUP_COMM)     ///< Log Group Identifier
 #define COMM_MGR_TASK_STACK                 (512u)              ///< Task stack size
-#define COMM_POLL_PERIOD                    (MSEC_100)
+#define COMM_POLL_PERIOD                    (MSEC_100)           ///< Wake period when no polled interface is connected (housekeeping only)
+#define COMM_POLL_PERIOD_ACTIVE             (MSEC_1)             ///< Poll period of UART interfaces while data is flowing
+#define COMM_POLL_PERIOD_IDLE               (MSEC_10)            ///< Poll period of idle UART interfaces. Bounds their Rx latency.
+#define COMM_ACTIVE_HOLD_TIME               (MSEC_20)            ///< Time after the last transfer that UARTs are polled at the active period
+#define COMM_USB_RX_WAIT                    (MSEC_100)           ///< Max USB Rx wait. Paces the dispatcher while USB is connected.
 #define TWO_MIN_TIMEOUT                     (MIN_2)              ///< Timeout count for 2 Min
 #define FIVE_SEC_COUNT                      (50u)                ///< Timeout count for 5 sec
 #define MAX_COUNT                           (65535u)             ///< Maximum 16byte value
@@ -125,6 +129,7 @@ static bool Uart0Rx(uint8_t *pData, uint16_t *pCount);
 static bool Uart0Tx(uint8_t *pData, uint16_t *pCount);
 
 static OS_EVENT *pMutexCommMgr = NULL;                          // Communication manager mutex
+static OS_EVENT *pSemCommMgrWake = NULL;                        // Wakes the Communication manager task
 static CIR_BUFF UsbRxCirBuff;                                   // Rx data circular buffer
 static CIR_BUFF UsbTxCirBuff;                                   // Tx data circular buffer
 
@@ -163,7 +168,8 @@ static COMM_IF  *pActiveInterface;                      // Active Interface poin
 /******************************************************************************/
 static void CommMgrTask(void *pArg);
 static void UsbCallback(USB_EVENT Event);
-static void Dispatcher(void);
+static bool Dispatcher(void);
+static uint32_t DispatcherWaitTime(uint32_t LastTransferTime);
 static void InterfaceInit(void);
 static COMM_MGR_STATUS CommSend(COMM_CONN Type, uint8_t *pData, uint16_t *pSize);
 static COMM_MGR_STATUS CommReceive(COMM_CONN Type, uint8_t *pData, uint16_t *pSize);
@@ -192,13 +198,19 @@ static void CommMgrTask(void *pArg)
     uint32_t ElapsedTime;
     uint32_t WifiInitTime;
     uint32_t WifiCheckTime;
+    uint32_t LastTransferTime;
+    uint8_t  OsError;
 
     WifiInitTime = SigTime();
+    LastTransferTime = SigTime();
 
     while (true)
     {
         /* Call the dispatchers for all the interfaces */
-        Dispatcher();
+        if (Dispatcher())
+        {
+            LastTransferTime = SigTime();
+        }
         do
         {
             WifiCheckTime = SigTime();
@@ -234,12 +246,59 @@ static void CommMgrTask(void *pArg)
             }
         } while (false);
 
-        /// \todo 02/17/2022 SE - Reduced time out from 100ms to 1ms for MCP. Instead of delay, can have some  protection using semaphore
-        /* Wait for 1 msec */
-        OSTimeDly(MSEC_1);
+        /* Wait for Tx data or a connection event, or until the interfaces must be polled again */
+        OSSemPend(pSemCommMgrWake, DispatcherWaitTime(LastTransferTime), &OsError);
+
+        /* One dispatch handles all the wakes posted so far */
+        while (OSSemAccept(pSemCommMgrWake) > 0)
+        {
+        }
     }
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Dispatcher wait time
+ *
+ * \details Returns how long the task may sleep before the next dispatch, if
+ *          not woken first. USB receive blocks in the USB stack until data
+ *          arrives (up to COMM_USB_RX_WAIT), so USB needs no polling here. The
+ *          UART interfaces (Adapter, WLAN) have no Rx interrupt and are polled:
+ *          quickly while data is flowing, and at COMM_POLL_PERIOD_IDLE when quiet.
+ *          With nothing to poll, the task wakes only for housekeeping.
+ *
+ * \param   LastTransferTime - Time of the last data transfer on any interface
+ *
+ * \return  uint32_t - Wait time in mS (never 0, as 0 waits forever)
+ *
+ * ========================================================================== */
+static uint32_t DispatcherWaitTime(uint32_t LastTransferTime)
+{
+    uint32_t WaitTime;
+
+    do
+    {
+        WaitTime = COMM_POLL_PERIOD_ACTIVE;
+
+        /* USB Rx wait has already paced this dispatch */
+        BREAK_IF(CommMgrInfo[COMM_USB].IsConnected);
+
+        if ((SigTime() - LastTransferTime) < COMM_ACTIVE_HOLD_TIME)
+        {
+            /* Data flowing on a polled interface - response likely soon */
+            BREAK_IF(CommMgrInfo[COMM_UART0].IsConnected || CommMgrInfo[COMM_WLAN].IsConnected);
+        }
+
+        WaitTime = COMM_POLL_PERIOD_IDLE;
+        BREAK_IF(CommMgrInfo[COMM_UART0].IsConnected || CommMgrInfo[COMM_WLAN].IsConnected);
+
+        WaitTime = COMM_POLL_PERIOD;
+
+    } while (false);
+
+    return WaitTime;
+}
+
 /* ========================================================================== */
 /**
  * \brief   Common dispatcher for the interfaces
@@ -248,23 +307,26 @@ static void CommMgrTask(void *pArg)
  *
  * \param   < None >
  *
- * \return  None
+ * \return  bool - true if data was received or sent on any interface
  *
  * ========================================================================== */
-static void Dispatcher(void)
+static bool Dispatcher(void)
 {
     uint8_t  Index;                             // Contains iteration index
     uint8_t  OsError;                           // contains the OS error status
-    uint16_t DataLen;                           // Data Length
     bool     IsTransferOk;                      // Transfer Ok flag
+    bool     IsTransfer;                        // Data moved on an interface
     static uint8_t  CommData[MAX_DATA_BYTES];   // Data in buffer
 
     uint16_t ReceivedCount;                     // Received count
     uint16_t ActDataLen;                        // Actual data Length
+    uint8_t  *pTxData;                          // Transmit data, in the Tx circular buffer
+    uint16_t SpanLen;                           // Contiguous Tx data length
+    uint8_t  Span;                              // Tx span iteration index
     uint16_t CircBufspace;                      // Space remaining in circular buffer
 
     ReceivedCount = MAX_DATA_BYTES;
-    DataLen = 0;
+    IsTransfer = false;
 
     /* Call the dispatchers for all the interfaces */
     for (Index = COMM_WLAN; Index < COMM_COUNT; Index++)
@@ -298,33 +360,52 @@ static void Dispatcher(void)
 
                 /* Set the USBActivity flag to true to indicate the Communication ongoing */
                 USBActivity = true;
+                IsTransfer = true;
             }
 
-            IsTransferOk = true;
-            /* Check if data is available in the transmit buffer */
-            DataLen = CirBuffCount(CommMgrInfo[Index].pTxCirBuff);
-            if (DataLen > 0)
+            /* Send the data in the transmit buffer in place. Data that wraps the end of
+               the buffer is in two contiguous spans, both are sent in the same pass. */
+            for (Span = 0; Span < 2; Span++)
             {
-                /* Read data from the circular buffer */
-                ActDataLen = CirBuffPeek(CommMgrInfo[Index].pTxCirBuff, CommData, DataLen);
+                OSMutexPend(pMutexCommMgr, OS_WAIT_FOREVER, &OsError);
+                SpanLen = CirBuffReadSpan(CommMgrInfo[Index].pTxCirBuff, &pTxData);
+                OSMutexPost(pMutexCommMgr);
+
+                if (0 == SpanLen)
+                {
+                    break;
+                }
 
                 /* Send data to specific interface */
-                IsTransferOk = CommMgrInfo[Index].pWrite(CommData, &ActDataLen);
+                ActDataLen = SpanLen;
+                IsTransferOk = CommMgrInfo[Index].pWrite(pTxData, &ActDataLen);
 
-                if (!IsTransferOk)
+                if (IsTransferOk)
                 {
-                    /*  Mutex lock */
-                    OSMutexPend(pMutexCommMgr, OS_WAIT_FOREVER, &OsError);
+                    /* Send failed, retry on the next pass */
+                    break;
+                }
+
+                /*  Mutex lock */
+                OSMutexPend(pMutexCommMgr, OS_WAIT_FOREVER, &OsError);
 
-                    /* Remove data from the circular buffer */
-                    CirBuffPop(CommMgrInfo[Index].pTxCirBuff, ActDataLen);
+                /* Remove data from the circular buffer */
+                CirBuffPop(CommMgrInfo[Index].pTxCirBuff, ActDataLen);
 
-                    /* Mutex release */
-                    OSMutexPost(pMutexCommMgr);
+                /* Mutex release */
+                OSMutexPost(pMutexCommMgr);
+                IsTransfer = true;
+
+                if (ActDataLen < SpanLen)
+                {
+                    /* Interface took part of the span, send the rest on the next pass */
+                    break;
                 }
             }
         }
     }
+
+    return IsTransfer;
 }
 
 /* ========================================================================== */
@@ -348,7 +429,7 @@ static bool UsbRx(uint8_t *pData, uint16_t *pCount)
 
     TransferStatus = true;  // Default to error
 
-    if (USB_STATUS_OK == L3_UsbReceive(pData,  MAX_DATA_BYTES, MSEC_100, pCount))
+    if (USB_STATUS_OK == L3_UsbReceive(pData,  MAX_DATA_BYTES, COMM_USB_RX_WAIT, pCount))
     {
         TransferStatus = false;
         ActiveConn = COMM_USB;
@@ -460,6 +541,7 @@ static void UsbCallback(USB_EVENT Event)
     }
 
     UpdateActiveConnection();
+    L4_CommManagerWake();
 
     /* Update the USB Active interface in Console manager */
     /* This is required since the WLAN/USB may be initialzed even after console manager initialization */
@@ -528,6 +610,9 @@ static COMM_MGR_STATUS CommSend(COMM_CONN Type, uint8_t *pData, uint16_t *pSize)
         /* Mutex release */
         OSMutexPost(pMutexCommMgr);
 
+        /* Send it now rather than at the next poll */
+        L4_CommManagerWake();
+
     } while (false);
 
     return Status;
@@ -755,6 +840,7 @@ static void WlanCallback(WLAN_EVENT Event)
     L3_WlanSetConnectStatus(true);
     CommMgrInfo[COMM_WLAN].IsConnected = true;
     UpdateActiveConnection();
+    L4_CommManagerWake();
 
     /* Connect event */
     CommEvent = COMM_MGR_EVENT_CONNECT;
@@ -1206,7 +1292,7 @@ static void ClearUSBFlags(void)
 /**
  * \brief   Function to initialize the Communication Manager
  *
- * \details This function creates the communication manager task, mutex and timer
+ * \details This function creates the communication manager task, mutex and wake semaphore
  *
  * \param   < None >
  *
@@ -1240,6 +1326,16 @@ COMM_MGR_STATUS L4_CommManagerInit(void)
             break;
         }
 
+        pSemCommMgrWake = SigSemCreate(0, "L4-CommMgr-Wake", &OsError);
+
+        if (NULL == pSemCommMgrWake)
+        {
+            /* Couldn't create semaphore, exit with error */
+            CommMgrStatus = COMM_MGR_STATUS_ERROR;
+            Log(ERR, "L4_CommManagerInit: Comm Manager Semaphore Create Error - %d", OsError);
+            break;
+        }
+
         /* Inititialze the interfaces */
         InterfaceInit();
 
@@ -1308,6 +1404,9 @@ COMM_IF* L4_CommManagerConnOpen(COMM_CONN Type, COMM_HANDLER pHandler)
         /* Update the Active connection type */
         UpdateActiveConnection();
 
+        /* Start polling the connection */
+        L4_CommManagerWake();
+
     } while (false);
 
     return pConnection;
@@ -1366,6 +1465,32 @@ COMM_MGR_STATUS L4_CommManagerConnClose(COMM_IF *pConnection)
     return CommMgrStatus;
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Wake the Communication Manager
+ *
+ * \details Runs the dispatcher now instead of at its next poll. Called when Tx
+ *          data is queued or a connection changes. The Rx paths have no data
+ *          callback: USB Rx blocks in the dispatcher and the UART DMA rings are
+ *          polled. May be called from an ISR, or before the Communication
+ *          Manager is initialized.
+ *
+ * \note    While USB is connected the dispatcher is usually blocked in USB Rx,
+ *          so queued Tx data still waits up to COMM_USB_RX_WAIT.
+ *
+ * \param   < None >
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+void L4_CommManagerWake(void)
+{
+    if (NULL != pSemCommMgrWake)
+    {
+        (void)OSSemPost(pSemCommMgrWake);
+    }
+}
+
 /* ========================================================================== */
 /**
  * \brief   Function to read the USB connection status
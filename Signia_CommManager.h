@@ -88,6 +88,7 @@ typedef struct                          /// USB connected signal
 extern COMM_MGR_STATUS L4_CommManagerInit(void);
 extern COMM_IF *L4_CommManagerConnOpen(COMM_CONN Type, COMM_HANDLER pHandler);
 extern COMM_MGR_STATUS L4_CommManagerConnClose(COMM_IF *pConnection);
+extern void L4_CommManagerWake(void);
 extern uint8_t L4_USBConnectionStatus(void);
 extern bool L4_CommStatusActive(void);
 extern void SetUSBPortMode(bool Value);
@@ -275,6 +275,11 @@ typedef union{                          ///< structures to be added based on the
         uint8_t ScreenID;               ///  Screen to Play decision byte
     }SIGNIATONESCREEN;
     
+    struct{
+        uint16_t Count;                 ///< Number of CRC failures to inject
+        uint16_t Interval;              ///< Inject one failure every Interval FPGA transfers
+    }FPGACRC;
+
     struct {
           uint16_t MtrCW;               ///< ControlWord(Bit coded value) indicating which test to be performed
           uint16_t MtrCrntTrip;         ///< Signia Motor Current TRIP 
@@ -550,6 +555,7 @@ static void SimulateMotorCurrentTrip(void *pData, TESTDATA *pTdata, HOOKID HookI
 static void SimulateHandleProcFireCountSimulation(void *pData, TESTDATA *pTdata, HOOKID HookId);
 static void SimulateMemoryFenceErrors(void *pData, TESTDATA *pTdata, HOOKID HookId);
 static void SimulateFlashIntergityFault(void *pData, TESTDATA *pTdata, HOOKID HookId);
+static void SimulateFpgaCrcFailure(void *pData, TESTDATA *pTdata, HOOKID HookId);
 
 static void ClearTestManagerNoinitData(void);
 static void GetTestManagerNoinitData(TestManagerNoinitData *pData);
@@ -625,7 +631,8 @@ static const TM_TC_IF TestCaseIFTable[TC_COUNT] = {
     { TC_MOTOR_CRNTRIP_SIMULATION,      SimulateMotorCurrentTrip}, ///< TestID = 27 -> Signia Motor Current Trip Simulation 
     { TC_PROCEDURE_FIRE_CNT_SIMULATION, SimulateHandleProcFireCountSimulation }, ///< TestID = 28 -> Handle Procedure Fire Count Simulation 
     { TC_MEOMRY_FENCE_ERROR_SIMULATION, SimulateMemoryFenceErrors },    ///< TestID = 29 -> Handle Memory Errors (Fence) Simulation
-    { TC_MEMORY_FALUT_FLASH_INEGRITY,   SimulateFlashIntergityFault }  ///< TestID = 30 -> Memory Fault Internal Flash Integrity Check 
+    { TC_MEMORY_FALUT_FLASH_INEGRITY,   SimulateFlashIntergityFault }, ///< TestID = 30 -> Memory Fault Internal Flash Integrity Check 
+    { TC_FPGA_CRCFAIL,                  SimulateFpgaCrcFailure }       ///< TestID = 31 -> FPGA SPI CRC failure
 
 };
 
@@ -965,6 +972,8 @@ static void TestSimulateBattParam(void *pData, TESTDATA *pTdata, HOOKID HookId)
  *          b) All three Motors Stops with in the specified time
  *          c) All three Motors Controls the MOTOR speed within 10% of the setpoint, within 200 ms of the set speed
  *             when motors are operating between Minimum RPM to Maximum RPM.
+ *          d) Speed overshoot for each speed step is reported when the step ends.
+ *          e) Control loop execution time (average & worst case) is reported every second.
  *
  * \param   pMotorData - Pointer to the motor control parameters
  *          pTdata     - Pointer to the motor Id's input data
@@ -989,8 +998,13 @@ static void TestSimulateMotorParam(void *pData, TESTDATA *pTdata, HOOKID HookId)
     static uint32_t IntialServotick;
     static uint32_t ElapsedServotime;
     static uint32_t ServoLogtime;
+    static uint32_t ServoTimeMax;
+    static uint32_t ServoTimeSum;
+    static uint32_t ServoSamples;
     static uint32_t PerValue;
     static uint8_t  SampleCntr[MAXMOTORIDS];
+    static uint32_t MotorPeakSpeed[MAXMOTORIDS];
+    uint32_t        SetSpeed;
 
       pMotorData = (MOTOR_CTRL_PARAM *)pData;
       switch(HookId)
@@ -1001,6 +1015,7 @@ static void TestSimulateMotorParam(void *pData, TESTDATA *pTdata, HOOKID HookId)
                  if( pTdata->MTR_PERFPARAM.MotorIDCW & ( 0x01 << MtrIdIndx) )
                  {
                     Motspeedidx[MtrIdIndx] = 0;
+                    MotorPeakSpeed[MtrIdIndx] = 0;
                     Signia_MotorStart((MOTOR_ID)MotrID[MtrIdIndx], MOT_POS, MotrSpeed[Motspeedidx[MtrIdIndx]], MOTSTARTUPDELAY, MOT_RUN_TIMEOUT, MOTCURNTTRIP, MOTCURNTLMT, true, MOTOR_VOLT_15, 0);
                     MotorRunTime[MtrIdIndx] = SigTime();
                     MotorSpeedTestStatus[MtrIdIndx] = false;
@@ -1013,6 +1028,8 @@ static void TestSimulateMotorParam(void *pData, TESTDATA *pTdata, HOOKID HookId)
             {
                 /*calculating the percentage value of the MOTOR speed within 10% of the set speed. for all defined speeds */
                 PerValue = (uint32_t)(( MotrSpeed[Motspeedidx[pMotorData->MotorId]] * HANDLE_PARAM_GEAR_RATIO)*0.1 );
+                SetSpeed = (uint32_t)(MotrSpeed[Motspeedidx[pMotorData->MotorId]] * HANDLE_PARAM_GEAR_RATIO);
+                MotorPeakSpeed[pMotorData->MotorId] = MAX(MotorPeakSpeed[pMotorData->MotorId], pMotorData->MotorAvgSpeed);
 
                 if( ( pMotorData->MotorAvgSpeed <=  ((MotrSpeed[Motspeedidx[pMotorData->MotorId]] * HANDLE_PARAM_GEAR_RATIO) + PerValue )) &&
                     ( pMotorData->MotorAvgSpeed >=  ((MotrSpeed[Motspeedidx[pMotorData->MotorId]] * HANDLE_PARAM_GEAR_RATIO) - PerValue )) )
@@ -1043,7 +1060,13 @@ static void TestSimulateMotorParam(void *pData, TESTDATA *pTdata, HOOKID HookId)
 
                 if((SigTime() - MotorRunTime[pMotorData->MotorId]) >= SEC_5 )
                 {
-                    if( Motspeedidx[pMotorData->MotorId] < MAXSPEEDSTORUN )
+                    /* Speed step done - report overshoot (peak average speed above the set speed) */
+                    Log(TST, "TestManager: Motor ID: %d, Setting Speed: %ld, Peak Speed: %lu, Overshoot: %lu%%",
+                           pMotorData->MotorId, SetSpeed, MotorPeakSpeed[pMotorData->MotorId],
+                           (MotorPeakSpeed[pMotorData->MotorId] > SetSpeed) ? (((MotorPeakSpeed[pMotorData->MotorId] - SetSpeed) * 100) / MAX(SetSpeed, 1)) : 0);
+                    MotorPeakSpeed[pMotorData->MotorId] = 0;
+
+                    if( (Motspeedidx[pMotorData->MotorId] + 1) < MAXSPEEDSTORUN )
                     {
                         MotorRunTime[pMotorData->MotorId] = SigTime();
                         MotorSettlingTime[pMotorData->MotorId] = SigTime();
@@ -1071,15 +1094,23 @@ static void TestSimulateMotorParam(void *pData, TESTDATA *pTdata, HOOKID HookId)
 
       case HOOK_MTRSERVOSTART:/* Motor Servo Loop time execution Test:- Warning. No other task should resetting the CPU_COUNTER. Currently No other task is using it.*/
             IntialServotick = CPU_COUNTER_READ();
-            ServoLogtime = SigTime();
             break;
 
       case HOOK_MTRSERVOEND:
             ElapsedServotime = GetServoTimeElapsed(IntialServotick);
+            ServoTimeMax = MAX(ServoTimeMax, ElapsedServotime);
+            ServoTimeSum += ElapsedServotime;
+            ServoSamples++;
 
-            if( 0 == ServoLogtime%1000 )
+            /* Report average & worst case once a second rather than a single sample */
+            if( (SigTime() - ServoLogtime) >= SEC_1 )
             {
-              Log(TST, "TestManager: Control Loop Execution Time = %lu microSeconds", ElapsedServotime);
+              Log(TST, "TestManager: Control Loop Execution Time = %lu microSeconds (Max %lu, %lu cycles)",
+                     ServoTimeSum / ServoSamples, ServoTimeMax, ServoSamples);
+              ServoLogtime = SigTime();
+              ServoTimeMax = 0;
+              ServoTimeSum = 0;
+              ServoSamples = 0;
             }
             break;
         default:
@@ -1354,6 +1385,47 @@ static void SimulateCRCFailures(void *pData, TESTDATA *pTdata, HOOKID id)
     } while ( false );
 }
 
+/* ========================================================================== */
+/**
+ * \brief   Test to Simulate FPGA SPI CRC Failures
+ *
+ * \details The FPGA is polled many times per millisecond, so failures are injected
+ *          one per Interval transfers until Count failures have been injected.
+ *          The charger SPI link keeps its own hook (HOOK_SPICRCFAIL) and is not affected.
+ *
+ * \param   pData    - Pointer to the calculated CRC of the FPGA transfer
+ *          pTdata   - Pointer to the input data ( failure count, interval )
+ *          HookId   - Hook Id represents the Function call Parameter
+ *
+ * \return  None
+ *
+ * ========================================================================== */
+static void SimulateFpgaCrcFailure(void *pData, TESTDATA *pTdata, HOOKID HookId)
+{
+    static uint16_t TransferCount;      /* FPGA transfers since the last injected failure */
+
+    do
+    {
+        if (HOOK_TM == HookId)
+        {
+            /* Test (re)started */
+            TransferCount = 0;
+            break;
+        }
+
+        BREAK_IF((HOOK_FPGACRCFAIL != HookId) || (NULL == pData) || (NULL == pTdata));
+        BREAK_IF(0 == pTdata->FPGACRC.Count);
+
+        TransferCount++;
+        BREAK_IF(TransferCount < pTdata->FPGACRC.Interval);
+        TransferCount = 0;
+
+        pTdata->FPGACRC.Count--;
+        *(uint16_t*)(pData) = *(uint16_t*)(pData) + ONE;
+        Log(TST, "TestManager: Simulating FPGA SPI CRC Failure, %d left", pTdata->FPGACRC.Count);
+    } while (false);
+}
+
 /* ========================================================================== */
 /**
  * \brief   Test to Simulating the Battery Falsh data Parameters
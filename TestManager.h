@@ -111,6 +111,7 @@ typedef enum {
     HOOK_RETRACT_MTR_CRNT_SIMULATE,
     HOOK_PROCEDURE_FIRE_CNT_SIMULATE,
     HOOK_FLASH_INTEGRITY_SIMULATE,
+    HOOK_FPGACRCFAIL,
     HOOK_TM,
     HOOK_COUNT
 } HOOKID;
@@ -147,6 +148,7 @@ typedef enum{
     TC_PROCEDURE_FIRE_CNT_SIMULATION, 	///< TestID = 28 -> Handle Procedure And Fire Count Simulation 
     TC_MEOMRY_FENCE_ERROR_SIMULATION, 	///< TestID = 29 -> Handle Memory Errors (Fence) Simulation
     TC_MEMORY_FALUT_FLASH_INEGRITY,     ///< TestID = 30 -> Memory Fault Internal Flash Integrity Check
+    TC_FPGA_CRCFAIL,                    ///< TestID = 31 -> FPGA SPI CRC failure
     TC_COUNT
 } TESTCASE;
 